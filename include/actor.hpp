@@ -94,12 +94,16 @@ public:
     virtual const Clr& clr() {return clr_;}
     const Tile_id& tile() const   {return tile_;}
 
-    void add_light(bool light_map[MAP_W][MAP_H]) const;
+    Lgt_size lgt_size() const;
 
-    virtual void add_light_(bool light[MAP_W][MAP_H]) const {(void)light;}
+    virtual Lgt_size lgt_size_() const {return Lgt_size::none;}
 
     void teleport();
 
+    //Moves the actor - always use this instead of assigning "pos" directly, so that the
+    //actor position index in game_time is kept up to date
+    void set_pos(const Pos& new_pos);
+
     bool is_alive() const {return state_ == Actor_state::alive;}
     bool is_corpse() const {return state_ == Actor_state::corpse;}
     Actor_state state() const {return state_;}
@@ -148,7 +148,7 @@ struct Actor_data_t
 namespace actor_data
 {
 
-extern Actor_data_t data[int(Actor_id::END)];
+extern thread_local Actor_data_t data[int(Actor_id::END)];
 
 void init();
 
@@ -113,6 +113,12 @@ protected:
     virtual void on_std_turn_() {}
 
     int group_size();
+
+    //Unaware monsters far away from anything they could target, and not standing in
+    //light, are dormant - they only wander around, and skip the target search, spell
+    //casting and path finding. They wake up when they become aware (e.g. by hearing a
+    //sound), when the player or an ally of the player comes close, or when lit.
+    bool is_dormant() const;
 };
 
 class Rat: public Mon
@@ -8,6 +8,13 @@ void init();
 
 void act();
 
+//A bot "run" goes from the first dungeon level down to the max level, then starts over
+//from the first level (the max level is not reset by init)
+void set_max_dlvl(const int DLVL);
+
+//Number of runs finished since init
+int nr_runs_finished();
+
 } //Bot
 
 #endif
@@ -0,0 +1,46 @@
+#ifndef BOT_FARM_H
+#define BOT_FARM_H
+
+#include <string>
+
+#include "cmn_data.hpp"
+
+//Runs the bot without any user interface (no window, sound, popups, etc), e.g. for soak
+//tests and performance measurements. To use several cores, the runs are spread over
+//workers, each playing with its own seed. The workers run either in separate processes,
+//or on a pool of threads in this process (the game sessions are thread local).
+namespace bot_farm
+{
+
+struct Opts
+{
+    Opts() :
+        seed                (0),
+        nr_runs             (1),
+        max_dlvl            (DLVL_LAST),
+        nr_workers          (1),
+        nr_threads          (0),
+        mon_dormant_dist    (-1),
+        report_path         (),
+        snapshot_prefix     () {}
+
+    unsigned long   seed;               //Worker number N uses seed + N
+    int             nr_runs;            //Runs to max_dlvl, for all workers together
+    int             max_dlvl;
+    int             nr_workers;
+    int             nr_threads;         //If 0, each worker runs in its own process
+    int             mon_dormant_dist;   //If negative, the game's default is used
+    std::string     report_path;        //JSON if the file name ends with ".json", else CSV
+
+    //If set, each worker draws the screen in memory, and saves it to the file
+    //"<snapshot_prefix><seed>.ppm" when its games are finished (not with threads, since
+    //the screen is shared by the whole process)
+    std::string     snapshot_prefix;
+};
+
+//Returns the exit code for the program (non-zero if any worker crashed)
+int run(const Opts& opts);
+
+} //bot_farm
+
+#endif
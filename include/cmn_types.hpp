@@ -326,4 +326,17 @@ enum class Lgt_size
     fov
 };
 
+enum class Fov_algo
+{
+    ray,        //One precalculated line per cell in the FOV box
+    shadow_cast //Recursive shadow casting, each cell is visited once
+};
+
+enum class Render_backend
+{
+    sdl,        //Drawn to a surface, which is presented in a window
+    mem,        //Drawn to a surface in memory only (see render::save_ppm)
+    none        //Nothing is drawn (no video needed, e.g. for the bot and tests)
+};
+
 #endif
@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "cmn_types.hpp"
+
 namespace config
 {
 
@@ -27,12 +29,22 @@ bool            is_tiles_wall_full_square();
 bool            is_audio_enabled();
 bool            is_bot_playing();
 void            toggle_bot_playing();
+
+//Unaware monsters further away than this from the player (and the player's allies) run
+//a cheap "dormant" AI (see Mon::is_dormant). Zero or less means no monster is dormant.
+int             mon_dormant_dist();
+void            set_mon_dormant_dist(const int DIST);
 bool            is_ranged_wpn_meleee_prompt();
 bool            is_ranged_wpn_auto_reload();
 bool            is_intro_lvl_skipped();
 int             delay_projectile_draw();
 int             delay_shotgun();
 int             delay_explosion();
+Fov_algo        fov_algo();
+
+//The render backend is not stored in the config file. It must be set before init.
+Render_backend  render_backend();
+void            set_render_backend(const Render_backend backend);
 
 } //Config
 
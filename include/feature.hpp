@@ -36,7 +36,7 @@ public:
     virtual bool is_bottomless() const;
     virtual char glyph() const;
     virtual Tile_id tile() const;
-    virtual void add_light(bool light[MAP_W][MAP_H]) const;
+    virtual Lgt_size lgt_size() const;
     virtual bool can_have_corpse() const;
     virtual bool can_have_rigid() const;
     virtual bool can_have_blood() const;
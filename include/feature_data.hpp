@@ -96,6 +96,11 @@ public:
 
     bool can_move_cmn() const {return can_move_cmn_;}
 
+    bool can_move_if_have_prop(const Prop_id id) const
+    {
+        return can_move_if_have_prop_[int(id)];
+    }
+
     bool can_move(const bool actor_prop_ids[size_t(Prop_id::END)]) const;
 
 private:
@@ -60,7 +60,7 @@ public:
 
     void reveal(const bool ALLOW_MESSAGE);
 
-    void set_to_secret() {is_open_ = is_secret_ = false;}
+    void set_to_secret();
 
     virtual Did_open open(Actor* const actor_opening) override;
 
@@ -79,6 +79,8 @@ public:
 private:
     Clr clr_() const override;
 
+    void set_open(const bool IS_OPEN);
+
     void on_hit(const Dmg_type dmg_type, const Dmg_method dmg_method,
                 Actor* const actor) override;
 
@@ -61,7 +61,7 @@ public:
     Clr         clr()                        const override;
 
     //TODO: Lit dynamite should add light on their own cell (just one cell)
-    //void add_light(bool light[MAP_W][MAP_H]) const;
+    //void add_light(Map_bits& light) const;
 
     void on_new_turn() override;
 
@@ -89,7 +89,7 @@ public:
 
     void on_new_turn() override;
 
-    void add_light(bool light[MAP_W][MAP_H]) const;
+    Lgt_size lgt_size() const override;
 
 private:
     int nr_turns_left_;
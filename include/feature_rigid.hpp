@@ -46,6 +46,10 @@ public:
     virtual Did_open open(Actor* const actor_opening);
     virtual void disarm();
 
+    //Makes the contained items of item containers (e.g. chests). This is normally done
+    //when the feature is created, but may be deferred (see map_gen::is_mk_items_deferred).
+    virtual void mk_items() {}
+
     void mk_bloody()
     {
         is_bloody_ = true;
@@ -61,9 +65,21 @@ public:
         return burn_state_;
     }
 
+    //Does this feature need new turn actions (see map::activate_rigid)?
+    bool is_active() const
+    {
+        return burn_state_ == Burn_state::burning || has_new_turn_actions();
+    }
+
 protected:
     virtual void on_new_turn_() {}
 
+    //Override this for features with specialized new turn actions
+    virtual bool has_new_turn_actions() const
+    {
+        return false;
+    }
+
     virtual void on_hit(const Dmg_type dmg_type, const Dmg_method dmg_method,
                         Actor* const actor) = 0;
 
@@ -464,6 +480,11 @@ public:
     void on_new_turn_() override;
 
 private:
+    bool has_new_turn_actions() const override
+    {
+        return true;
+    }
+
     Clr clr_() const override;
 
     void on_hit(const Dmg_type dmg_type, const Dmg_method dmg_method,
@@ -696,6 +717,8 @@ public:
     Tomb() = delete;
     ~Tomb() {}
 
+    void mk_items() override;
+
     Feature_id id() const override
     {
         return Feature_id::tomb;
@@ -737,6 +760,8 @@ public:
     Chest() = delete;
     ~Chest() {}
 
+    void mk_items() override;
+
     Feature_id id() const override
     {
         return Feature_id::chest;
@@ -786,6 +811,8 @@ public:
     Cabinet() = delete;
     ~Cabinet() {}
 
+    void mk_items() override;
+
     Feature_id id() const override
     {
         return Feature_id::cabinet;
@@ -863,6 +890,8 @@ public:
     Cocoon() = delete;
     ~Cocoon() {}
 
+    void mk_items() override;
+
     Feature_id id() const override
     {
         return Feature_id::cocoon;
@@ -4,6 +4,8 @@
 #include "cmn_data.hpp"
 #include "cmn_types.hpp"
 
+class Map_bits;
+
 namespace fov
 {
 
@@ -11,12 +13,21 @@ bool check_cell(const bool obstructions[MAP_W][MAP_H],
                 const Pos& cell_to_check,
                 const Pos& origin, const bool IS_AFFECTED_BY_DARKNESS);
 
+//NOTE: These use the FOV algorithm set in the config
 void run_player_fov(const bool obstructions[MAP_W][MAP_H], const Pos& origin);
 
 void run_fov_on_array(const bool obstructions[MAP_W][MAP_H], const Pos& origin,
                       bool values[MAP_W][MAP_H],
                       const bool IS_AFFECTED_BY_DARKNESS);
 
+void run_fov_on_array(const bool obstructions[MAP_W][MAP_H], const Pos& origin,
+                      bool values[MAP_W][MAP_H],
+                      const bool IS_AFFECTED_BY_DARKNESS, const Fov_algo algo);
+
+//Sets the cells lit by a light source with the same radius as the field of view (e.g. a
+//flare). Only the cells within that radius are read.
+void add_fov_light(const Pos& origin, Map_bits& light);
+
 } //fov
 
 #endif
@@ -21,12 +21,16 @@ enum class Turn_type
 namespace game_time
 {
 
-extern std::vector<Actor*> actors_;
-extern std::vector<Mob*> mobs_;
+extern thread_local std::vector<Actor*> actors_;
+extern thread_local std::vector<Mob*> mobs_;
 
 void init();
 void cleanup();
 
+//Swaps the actors, mobs, turn queue and light map with the level which is not currently
+//played (call this through map::swap_lvl)
+void swap_lvl();
+
 void store_to_save_lines(std::vector<std::string>& lines);
 void setup_from_save_lines(std::vector<std::string>& lines);
 
@@ -38,10 +42,21 @@ int turn();
 
 Actor* cur_actor();
 
+//Lets the current actor act (or only ends its turn, if it cannot act)
+void run_cur_actor_turn();
+
 void erase_actor_in_element(const size_t i);
 
 void mobs_at_pos(const Pos& pos, std::vector<Mob*>& vector_ref);
 
+//The actors and mobs are also indexed by position, for constant time lookup of what is
+//in a cell. Actors must be moved with Actor::set_pos (which calls the function below)
+//to keep the index up to date.
+const std::vector<Actor*>& actors_at_pos(const Pos& pos); //Actors in any state
+const std::vector<Mob*>& mobs_at_pos(const Pos& pos);
+
+void on_actor_moved(Actor& actor, const Pos& old_pos);
+
 void add_mob(Mob* const f);
 
 void erase_mob(Mob* const f, const bool DESTROY_OBJECT);
@@ -50,8 +65,19 @@ void erase_all_mobs();
 
 void reset_turn_type_and_actor_counters();
 
+//Queues the actor again according to its current speed (call when the speed may have
+//changed, e.g. when hasted or slowed)
+void on_actor_speed_changed(const Actor& actor);
+
+//Updates which cells are lit (incrementally - see game_time.cpp)
 void update_light_map();
 
+//Forgets all light sources and sets all cells to unlit (call when the cells are reset)
+void reset_light_map();
+
+//Increases each time any cell becomes lit or unlit
+int light_map_revision();
+
 } //game_time
 
 #endif
@@ -31,6 +31,12 @@ void set_random_god();
 
 void set_no_god();
 
+//Sets the god by its entry in the god list (as returned by cur_god), or no god if null
+void set_god(const God* const god);
+
+//Swaps the god with the level which is not currently played (see map::swap_lvl)
+void swap_lvl();
+
 } //Gods
 
 #endif
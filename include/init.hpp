@@ -58,8 +58,8 @@
 namespace init
 {
 
-extern bool is_cheat_vision_enabled;
-extern bool quit_to_main_menu;
+extern thread_local bool is_cheat_vision_enabled;
+extern thread_local bool quit_to_main_menu;
 
 void init_iO();
 void cleanup_iO();
@@ -67,6 +67,15 @@ void cleanup_iO();
 void init_game();
 void cleanup_game();
 
+//The session state - the map, actors, item and monster data, message log, etc, i.e. all
+//that is set up by init_session - is thread local. Each thread plays in its own world, so
+//several sessions (e.g. bot games) can run in parallel. The game data and IO (set up by
+//init_game and init_iO) is shared by all threads, and must be set up by the main thread
+//before any other threads start.
+//
+//Each access to a thread local object with a constructor or destructor, defined in another
+//file, goes through a function call, so avoid that for data used in hot loops (see
+//map::cells).
 void init_session();
 void cleanup_session();
 
@@ -108,9 +108,17 @@ public:
     void store_to_save_lines(std::vector<std::string>& lines) const;
     void setup_from_save_lines(std::vector<std::string>& lines);
 
+    //Incremented whenever any inventory (or the carrier properties of any item) changes,
+    //so that information derived from inventories can be cached (see Prop_handler)
+    static int revision() {return revision_;}
+    static void on_changed() {++revision_;}
+
     Inv_slot               slots_[int(Slot_id::END)];
     std::vector<Item*>    general_;
     std::vector<Item*>    intrinsics_;
+
+private:
+    static thread_local int revision_;
 };
 
 #endif
@@ -12,9 +12,9 @@ enum class Unequip_allowed  {yes, no};
 namespace inv_handling
 {
 
-extern Inv_scr_id   scr_to_open_after_drop;
-extern Inv_slot*    equip_slot_to_open_after_drop;
-extern int          browser_idx_to_set_after_drop;
+extern thread_local Inv_scr_id   scr_to_open_after_drop;
+extern thread_local Inv_slot*    equip_slot_to_open_after_drop;
+extern thread_local int          browser_idx_to_set_after_drop;
 
 void init();
 
@@ -315,7 +315,7 @@ class Item;
 namespace item_data
 {
 
-extern Item_data_t data[int(Item_id::END)];
+extern thread_local Item_data_t data[int(Item_id::END)];
 
 void init();
 void cleanup();
@@ -10,9 +10,12 @@
 #include "feature.hpp"
 #include "config.hpp"
 #include "actor_player.hpp"
+#include "map_bits.hpp"
 
 class Save_handler;
 class Rigid;
+class Mob;
+class God;
 
 struct Cell
 {
@@ -28,6 +31,16 @@ struct Cell
     Pos                 pos;
 };
 
+//Persistent obstruction layers kept by the map (see map::obstr_layer)
+enum class Obstr_layer
+{
+    los,
+    move_cmn,
+    projectiles,
+    sound,
+    END
+};
+
 enum class Map_type
 {
     intro,
@@ -39,16 +52,34 @@ enum class Map_type
     trapezohedron
 };
 
+//The layout of a level - its features, rooms and mobs, without any actors or items. A
+//layout can be moved out of the map of one session and into the map of another (see
+//map::export_layout and map::import_layout). It owns what it holds until imported.
+struct Lvl_layout
+{
+    Lvl_layout();
+    Lvl_layout(const Lvl_layout&) = delete;
+    ~Lvl_layout();
+
+    Rigid*              rigids[MAP_W][MAP_H];
+    bool                is_dark[MAP_W][MAP_H];
+    Room*               room_map[MAP_W][MAP_H];
+    std::vector<Room*>  room_list;
+    std::vector<Mob*>   mobs;
+    Clr                 wall_clr;
+    const God*          god;
+};
+
 namespace map
 {
 
-extern Player*              player;
-extern int                  dlvl;
-extern Cell                 cells[MAP_W][MAP_H];
-extern std::vector<Room*>   room_list;              //Owns the rooms
-extern Room*                room_map[MAP_W][MAP_H]; //Helper array
+extern thread_local Player*              player;
+extern thread_local int                  dlvl;
+extern thread_local Cell                 (*cells)[MAP_H];        //Set up by init
+extern thread_local std::vector<Room*>   room_list;              //Owns the rooms
+extern thread_local Room*                room_map[MAP_W][MAP_H]; //Helper array
 
-extern Clr                  wall_clr;
+extern thread_local Clr                  wall_clr;
 
 void init();
 void cleanup();
@@ -57,8 +88,60 @@ void setup_from_save_lines(std::vector<std::string>& lines);
 
 void reset_map();
 
+//Besides the current level, the map keeps a "back" level which is not played - with its
+//cells, monsters, mobs, etc. A level can be built off-screen by swapping the back level
+//in, building it, and swapping it out again - leaving the current level untouched (see
+//map_travel). The player is on both levels, at a separate position on each.
+void swap_lvl();
+
+//Makes the back level the current level, and clears the level which was left
+void enter_back_lvl();
+
+//Moves the features, rooms, mobs, wall color and god of the current level into the
+//layout, and leaves empty cells behind. There must be no actors or items on the level
+//except for the player.
+void export_layout(Lvl_layout& out);
+
+//Replaces the current level with the layout (leaving the layout empty). Actors and items
+//must be added afterwards, e.g. by map_gen::populate_std_lvl.
+void import_layout(Lvl_layout& layout);
+
 Rigid* put(Rigid* const rigid);
 
+//The obstruction layers are the results of the Blocks_los, Blocks_move_cmn (without
+//actors) and Blocks_projectiles cell checks, for the rigids and mobs. The sound layer
+//holds the cells with rigids which are not sound passable (mobs do not block sound).
+//Rather than parsing the whole map, these are updated per cell when something changes
+//there - a rigid is put, a door opens or closes, or a mob is added or erased.
+const Map_bits& obstr_layer(const Obstr_layer layer);
+
+//Re-evaluates the obstruction layers for the given cell (call this when the
+//passability of something in the cell has changed)
+void update_obstr_layers(const Pos& p);
+
+//Increases each time the obstruction layers are updated - data derived from the map
+//passability can be cached, and rebuilt when this number has changed
+int obstr_revision();
+
+//Have the obstruction layers been updated anywhere in the (inclusive) area since the
+//given revision? This allows caching data derived from a small part of the map.
+bool is_obstr_changed_in_area(const Rect& area, const int REVISION);
+
+//Rigids which need to run new turn actions (see Rigid::is_active) are registered as
+//active, and only these are visited each standard turn. Rigids are activated when put
+//on the map or when they start burning. The positions are sorted in column order (x,
+//then y), which is the order the whole map was previously visited in.
+void activate_rigid(const Pos& p);
+
+const std::vector<Pos>& active_rigid_positions();
+
+//Number of active positions up to and including p - i.e. the index to continue from
+//after visiting p, even if rigids were activated meanwhile
+size_t nr_active_rigids_up_to(const Pos& p);
+
+//Removes the positions where the rigid is no longer active (e.g. finished burning)
+void erase_inactive_rigids();
+
 //Makes a copy of the renderers current array
 //TODO: This is weird, and it's unclear how it should be used. Remove?
 //Can it not be copied in the map drawing function instead?
@@ -0,0 +1,87 @@
+#ifndef MAP_BITS_H
+#define MAP_BITS_H
+
+#include <cstdint>
+
+#include "cmn_data.hpp"
+#include "cmn_types.hpp"
+
+//Boolean map array stored as one bit per cell, with each map row packed into
+//machine words (row major). This is much smaller than a bool[MAP_W][MAP_H] array,
+//and cheap to keep around persistently.
+class Map_bits
+{
+public:
+    Map_bits() {clear();}
+
+    void clear();
+
+    bool at(const int X, const int Y) const
+    {
+        return (words_[Y][X / WORD_BITS] >> (X % WORD_BITS)) & 1;
+    }
+
+    bool at(const Pos& p) const {return at(p.x, p.y);}
+
+    void set(const int X, const int Y, const bool VAL)
+    {
+        const uint64_t MASK = uint64_t(1) << (X % WORD_BITS);
+
+        uint64_t& word = words_[Y][X / WORD_BITS];
+
+        word = VAL ? (word | MASK) : (word & ~MASK);
+    }
+
+    void set(const Pos& p, const bool VAL) {set(p.x, p.y, VAL);}
+
+    void to_array(bool out[MAP_W][MAP_H]) const;
+
+    void from_array(const bool in[MAP_W][MAP_H]);
+
+    //The operations below work on whole words at a time (64 cells per operation)
+
+    void set_all(const bool VAL);
+
+    void invert();
+
+    //Sets all cells which are set in the other map
+    void or_with(const Map_bits& other);
+
+    //Clears all cells which are set in the other map
+    void and_not(const Map_bits& other);
+
+    //Expands all set cells by the given distance (with diagonals, i.e. in a square).
+    //Cells outside the map are treated as not set.
+    void dilate(const int DIST = 1);
+
+    //Is any cell in the (inclusive) area set to VAL?
+    bool is_any_in_rect(const Rect& area, const bool VAL = true) const;
+
+    int popcount() const;
+
+    bool operator==(const Map_bits& other) const;
+
+    bool operator!=(const Map_bits& other) const {return !(*this == other);}
+
+private:
+    static const int WORD_BITS      = 64;
+    static const int WORDS_PER_ROW  = (MAP_W + WORD_BITS - 1) / WORD_BITS;
+
+    //Bits of the word at index I which belong to the map (the last word in each
+    //row has unused bits, which must always be kept cleared)
+    static uint64_t row_mask(const int I)
+    {
+        const int NR_BITS = MAP_W - (I * WORD_BITS);
+
+        return NR_BITS >= WORD_BITS ? ~uint64_t(0) : ((uint64_t(1) << NR_BITS) - 1);
+    }
+
+    //Sets the bits in the word at index I which are within [X0, X1]
+    static uint64_t x_range_mask(const int I, const int X0, const int X1);
+
+    void dilate_once();
+
+    uint64_t words_[MAP_H][WORDS_PER_ROW];
+};
+
+#endif
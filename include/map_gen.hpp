@@ -56,10 +56,27 @@ namespace map_gen
 //This variable is checked at certain points to see if the current map
 //has been flagged as "failed". Setting is_map_valid to false will generally
 //stop map generation, discard the map, and trigger generation of a new map.
-extern bool is_map_valid;
+extern thread_local bool is_map_valid;
+
+//When set, item containers (e.g. chests) are made empty, and their items are made later
+//by mk_deferred_items. This is used when the layout is made in another session than the
+//one which plays the level (see map_travel), since items must be made by the session
+//which owns the item data and the player.
+extern thread_local bool is_mk_items_deferred;
 
 bool mk_intro_lvl();
+
+//A standard level is made in two steps. The layout (rooms, features and doors) only
+//depends on the DLVL, and may be made in another session and moved to the current map
+//(see map::export_layout). Populating it places the player, monsters, traps, items and
+//stairs. The rooms are kept in between, and are deleted by populate_std_lvl.
 bool mk_std_lvl();
+bool mk_std_lvl_layout();
+bool populate_std_lvl();
+
+//Makes the items of all item containers on the map (see is_mk_items_deferred)
+void mk_deferred_items();
+
 bool mk_egypt_lvl();
 bool mk_leng_lvl();
 bool mk_rats_in_the_walls_lvl();
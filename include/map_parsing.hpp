@@ -1,29 +1,41 @@
 #ifndef MAP_PARSING_H
 #define MAP_PARSING_H
 
+#include <assert.h>
 #include <vector>
 
 #include "cmn_types.hpp"
 #include "config.hpp"
 #include "feature_data.hpp"
-
-struct Cell;
-class Mob;
-class Actor;
+#include "feature_rigid.hpp"
+#include "feature_mob.hpp"
+#include "actor.hpp"
+#include "map.hpp"
+#include "map_bits.hpp"
+#include "game_time.hpp"
+#include "utils.hpp"
 
 namespace cell_check
 {
 
+//Base class for the cell checks. The map parser is a template on the check type, so
+//there are no virtual functions here - instead the checks hide the functions below
+//which they need to override, and the calls are resolved (and inlined) at compile time.
+//NOTE: Checks which hide "check" must bring the remaining overloads back into scope
+//(with "using Check::check"), so that the map parser compiles for all check types.
 class Check
 {
 public:
-    virtual ~Check() {}
-    virtual bool is_checking_cells() const {return false;}
-    virtual bool is_checking_mobs()         const {return false;}
-    virtual bool is_checking_actors()       const {return false;}
-    virtual bool check(const Cell& c)       const {(void)c; return false;}
-    virtual bool check(const Mob& f) const {(void)f; return false;}
-    virtual bool check(const Actor& a)      const {(void)a; return false;}
+    bool is_checking_cells()        const {return false;}
+    bool is_checking_mobs()         const {return false;}
+    bool is_checking_actors()       const {return false;}
+    bool check(const Cell& c)       const {(void)c; return false;}
+    bool check(const Mob& f)        const {(void)f; return false;}
+    bool check(const Actor& a)      const {(void)a; return false;}
+
+    //If the result of the cell and mob checks is kept in one of the map obstruction
+    //layers, the check returns that layer here, and the map parser reads it directly
+    const Map_bits* obstr_layer()   const {return nullptr;}
 protected:
     Check() {}
 };
@@ -32,10 +44,21 @@ class Blocks_los : public Check
 {
 public:
     Blocks_los() : Check() {}
-    bool is_checking_cells()        const override {return true;}
-    bool is_checking_mobs()         const override {return true;}
-    bool check(const Cell& c)       const override;
-    bool check(const Mob& f)        const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool is_checking_mobs()         const {return true;}
+
+    bool check(const Cell& c)       const
+    {
+        return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->is_los_passable();
+    }
+
+    bool check(const Mob& f)        const {return !f.is_los_passable();}
+
+    const Map_bits* obstr_layer()   const
+    {
+        return &map::obstr_layer(Obstr_layer::los);
+    }
 };
 
 class Blocks_move_cmn : public Check
@@ -43,12 +66,23 @@ class Blocks_move_cmn : public Check
 public:
     Blocks_move_cmn(bool is_actors_blocking) :
         Check(), IS_ACTORS_BLOCKING_(is_actors_blocking) {}
-    bool is_checking_cells()        const override {return true;}
-    bool is_checking_mobs()         const override {return true;}
-    bool is_checking_actors()       const override {return IS_ACTORS_BLOCKING_;}
-    bool check(const Cell& c)       const override;
-    bool check(const Mob& f)        const override;
-    bool check(const Actor& a)      const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool is_checking_mobs()         const {return true;}
+    bool is_checking_actors()       const {return IS_ACTORS_BLOCKING_;}
+
+    bool check(const Cell& c)       const
+    {
+        return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->can_move_cmn();
+    }
+
+    bool check(const Mob& f)        const {return !f.can_move_cmn();}
+    bool check(const Actor& a)      const {return a.is_alive();}
+
+    const Map_bits* obstr_layer()   const
+    {
+        return &map::obstr_layer(Obstr_layer::move_cmn);
+    }
 private:
     const bool IS_ACTORS_BLOCKING_;
 };
@@ -57,12 +91,18 @@ class Blocks_actor : public Check
 {
 public:
     Blocks_actor(Actor& actor, bool is_actors_blocking);
-    bool is_checking_cells()        const override {return true;}
-    bool is_checking_mobs()         const override {return true;}
-    bool is_checking_actors()       const override {return IS_ACTORS_BLOCKING_;}
-    bool check(const Cell& c)       const override;
-    bool check(const Mob& f)        const override;
-    bool check(const Actor& a)      const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool is_checking_mobs()         const {return true;}
+    bool is_checking_actors()       const {return IS_ACTORS_BLOCKING_;}
+
+    bool check(const Cell& c)       const
+    {
+        return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->can_move(actors_props_);
+    }
+
+    bool check(const Mob& f)        const {return !f.can_move(actors_props_);}
+    bool check(const Actor& a)      const {return a.is_alive();}
 private:
     const bool IS_ACTORS_BLOCKING_;
     bool actors_props_[size_t(Prop_id::END)];
@@ -72,10 +112,21 @@ class Blocks_projectiles : public Check
 {
 public:
     Blocks_projectiles() : Check() {}
-    bool is_checking_cells()        const override {return true;}
-    bool is_checking_mobs()         const override {return true;}
-    bool check(const Cell& c)       const override;
-    bool check(const Mob& f)        const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool is_checking_mobs()         const {return true;}
+
+    bool check(const Cell& c)       const
+    {
+        return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->is_projectile_passable();
+    }
+
+    bool check(const Mob& f)        const {return !f.is_projectile_passable();}
+
+    const Map_bits* obstr_layer()   const
+    {
+        return &map::obstr_layer(Obstr_layer::projectiles);
+    }
 };
 
 class Living_actors_adj_to_pos : public Check
@@ -83,8 +134,14 @@ class Living_actors_adj_to_pos : public Check
 public:
     Living_actors_adj_to_pos(const Pos& pos) :
         Check(), pos_(pos) {}
-    bool is_checking_actors()       const override {return true;}
-    bool check(const Actor& a)      const override;
+    using Check::check;
+    bool is_checking_actors()       const {return true;}
+
+    bool check(const Actor& a)      const
+    {
+        return a.is_alive() && utils::is_pos_adj(pos_, a.pos, true);
+    }
+
     const Pos& pos_;
 };
 
@@ -92,17 +149,23 @@ class Blocks_items : public Check
 {
 public:
     Blocks_items() : Check() {}
-    bool is_checking_cells()        const override {return true;}
-    bool is_checking_mobs()         const override {return true;}
-    bool check(const Cell& c)       const override;
-    bool check(const Mob& f)        const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool is_checking_mobs()         const {return true;}
+
+    bool check(const Cell& c)       const
+    {
+        return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->can_have_item();
+    }
+
+    bool check(const Mob& f)        const {return !f.can_have_item();}
 };
 
 //class Corridor : public Check {
 //public:
 //  Corridor() : Check() {}
-//  bool is_checking_cells()        const override {return true;}
-//  bool check(const Cell& c)       const override;
+//  bool is_checking_cells()        const {return true;}
+//  bool check(const Cell& c)       const;
 //};
 
 // E.g. ##
@@ -111,16 +174,17 @@ public:
 //class Nook : public Check {
 //public:
 //  Nook() : Check() {}
-//  bool is_checking_cells()        const override {return true;}
-//  bool check(const Cell& c)       const override;
+//  bool is_checking_cells()        const {return true;}
+//  bool check(const Cell& c)       const;
 //};
 
 class Is_feature : public Check
 {
 public:
     Is_feature(const Feature_id id) : Check(), feature_(id) {}
-    bool is_checking_cells()        const override {return true;}
-    bool check(const Cell& c)       const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool check(const Cell& c)       const {return c.rigid->id() == feature_;}
 private:
     const Feature_id feature_;
 };
@@ -134,8 +198,17 @@ public:
     Is_any_of_features(const Feature_id id) :
         Check(), features_(std::vector<Feature_id> {id}) {}
 
-    bool is_checking_cells()        const override {return true;}
-    bool check(const Cell& c)       const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+
+    bool check(const Cell& c)       const
+    {
+        const Feature_id id = c.rigid->id();
+
+        for (auto f : features_) {if (f == id) return true;}
+
+        return false;
+    }
 private:
     std::vector<Feature_id> features_;
 };
@@ -144,8 +217,9 @@ class All_adj_is_feature : public Check
 {
 public:
     All_adj_is_feature(const Feature_id id) : Check(), feature_(id) {}
-    bool is_checking_cells()        const override {return true;}
-    bool check(const Cell& c)       const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool check(const Cell& c)       const;
 private:
     const Feature_id feature_;
 };
@@ -159,8 +233,9 @@ public:
     All_adj_is_any_of_features(const Feature_id id) :
         Check(), features_(std::vector<Feature_id> {id}) {}
 
-    bool is_checking_cells()        const override {return true;}
-    bool check(const Cell& c)       const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool check(const Cell& c)       const;
 private:
     std::vector<Feature_id> features_;
 };
@@ -169,8 +244,9 @@ class All_adj_is_not_feature : public Check
 {
 public:
     All_adj_is_not_feature(const Feature_id id) : Check(), feature_(id) {}
-    bool is_checking_cells()        const override {return true;}
-    bool check(const Cell& c)       const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool check(const Cell& c)       const;
 private:
     const Feature_id feature_;
 };
@@ -184,8 +260,9 @@ public:
     All_adj_is_none_of_features(const Feature_id id) :
         Check(), features_(std::vector<Feature_id> {id}) {}
 
-    bool is_checking_cells()        const override {return true;}
-    bool check(const Cell& c)       const override;
+    using Check::check;
+    bool is_checking_cells()        const {return true;}
+    bool check(const Cell& c)       const;
 private:
     std::vector<Feature_id> features_;
 };
@@ -201,9 +278,106 @@ namespace map_parse
 
 extern const Rect map_rect;
 
-void run(const cell_check::Check& check, bool out[MAP_W][MAP_H],
+//NOTE: This is a template on the check type (rather than taking a polymorphic check),
+//so that the check functions can be inlined into the loops below.
+template<typename Check_t>
+void run(const Check_t& check, bool out[MAP_W][MAP_H],
          const Map_parse_mode write_rule = Map_parse_mode::overwrite,
-         const Rect& area_to_check_cells = map_rect);
+         const Rect& area_to_check_cells = map_rect)
+{
+    assert(check.is_checking_cells()  ||
+           check.is_checking_mobs()   ||
+           check.is_checking_actors());
+
+    const bool ALLOW_WRITE_FALSE = write_rule == Map_parse_mode::overwrite;
+
+    const int X0 = area_to_check_cells.p0.x;
+    const int Y0 = area_to_check_cells.p0.y;
+    const int X1 = area_to_check_cells.p1.x;
+    const int Y1 = area_to_check_cells.p1.y;
+
+    const Map_bits* const obstr_layer = check.obstr_layer();
+
+    if (obstr_layer)
+    {
+        //The cells and mobs are already evaluated in the obstruction layer
+        for (int x = X0; x <= X1; ++x)
+        {
+            for (int y = Y0; y <= Y1; ++y)
+            {
+                const bool IS_MATCH = obstr_layer->at(x, y);
+
+                if (IS_MATCH || ALLOW_WRITE_FALSE)
+                {
+                    out[x][y] = IS_MATCH;
+                }
+            }
+        }
+    }
+    else //No obstruction layer
+    {
+        if (check.is_checking_cells())
+        {
+            for (int x = X0; x <= X1; ++x)
+            {
+                for (int y = Y0; y <= Y1; ++y)
+                {
+                    const bool IS_MATCH = check.check(map::cells[x][y]);
+
+                    if (IS_MATCH || ALLOW_WRITE_FALSE)
+                    {
+                        out[x][y] = IS_MATCH;
+                    }
+                }
+            }
+        }
+
+        if (check.is_checking_mobs())
+        {
+            for (const Mob* const mob : game_time::mobs_)
+            {
+                const Pos& p = mob->pos();
+
+                if (utils::is_pos_inside(p, area_to_check_cells))
+                {
+                    const bool IS_MATCH = check.check(*mob);
+
+                    if (IS_MATCH || ALLOW_WRITE_FALSE)
+                    {
+                        bool& v = out[p.x][p.y];
+
+                        if (!v) {v = IS_MATCH;}
+                    }
+                }
+            }
+        }
+    }
+
+    if (check.is_checking_actors())
+    {
+        for (const Actor* const actor : game_time::actors_)
+        {
+            const Pos& p = actor->pos;
+
+            if (utils::is_pos_inside(p, area_to_check_cells))
+            {
+                const bool IS_MATCH = check.check(*actor);
+
+                if (IS_MATCH || ALLOW_WRITE_FALSE)
+                {
+                    bool& v = out[p.x][p.y];
+
+                    if (!v) {v = IS_MATCH;}
+                }
+            }
+        }
+    }
+}
+
+//Sets each element to the number of steps (with diagonals) to the nearest cell set in
+//the input array. If no cell is set, all elements are set to MAP_W + MAP_H.
+//This runs in linear time (two passes over the map).
+void chebyshev_dist_field(const bool in[MAP_W][MAP_H], int out[MAP_W][MAP_H]);
 
 //Given a map array of booleans, this will fill a second map array of boolens
 //where the cells are set to true if they are within the specified distance
@@ -214,15 +388,22 @@ void cells_within_dist_of_others(const bool in[MAP_W][MAP_H], bool out[MAP_W][MA
 
 bool is_val_in_area(const Rect& area, const bool in[MAP_W][MAP_H], const bool VAL = true);
 
+bool is_val_in_area(const Rect& area, const Map_bits& in, const bool VAL = true);
+
 void append(bool base[MAP_W][MAP_H], const bool append[MAP_W][MAP_H]);
 
+void append(Map_bits& base, const Map_bits& append);
+
 //Optimized for expanding with a distance of one
 void expand(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H],
             const Rect& area_allowed_to_modify = Rect(0, 0, MAP_W, MAP_H));
 
-//Slower version that can expand any distance
+//Can expand any distance (uses the distance field above)
 void expand(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H], const int DIST);
 
+//Same result as the array version above, but works on whole words
+void expand(const Map_bits& in, Map_bits& out, const int DIST = 1);
+
 bool is_map_connected(const bool blocked[MAP_W][MAP_H]);
 
 } //map_parse
@@ -239,9 +420,18 @@ public:
 namespace flood_fill
 {
 
+//Sets each reached cell to the number of steps from the origin. The origin, and all cells
+//which are not reached (blocked, further away than the travel limit, or on the map edge)
+//are set to zero. If a target (p1) is given, the flood fill stops when it is reached.
 void run(const Pos& p0, const bool blocked[MAP_W][MAP_H], int out[MAP_W][MAP_H],
          int travel_lmt, const Pos& p1, const bool ALLOW_DIAGONAL);
 
+//Same as above, but floods from several origins at once - each cell is set to the number
+//of steps from the nearest origin. All origins are set to zero.
+void run(const std::vector<Pos>& origins, const bool blocked[MAP_W][MAP_H],
+         int out[MAP_W][MAP_H], int travel_lmt, const Pos& p1,
+         const bool ALLOW_DIAGONAL);
+
 } //Flood_fill
 
 namespace path_find
@@ -255,6 +445,10 @@ namespace path_find
 //                        more optimized and is the default behavior (best for e.g. AI),
 //                        while the randomized method can produces nicer results in some
 //                        cases (e.g. corridors).
+//---------------------------------------------------------------------------------------
+//The path is found with an A* search, which gives exactly the same paths (and step
+//choices) as walking back along a flood fill from the origin, but only visits the cells
+//which could be part of a shortest path. Nothing is allocated except the output path.
 void run(const Pos& p0, const Pos& p1, bool blocked[MAP_W][MAP_H], std::vector<Pos>&  out,
          const bool ALLOW_DIAGONAL = true, const bool RANDOMIZE_STEP_CHOICES = false);
 
@@ -21,19 +21,33 @@ struct map_data
 namespace map_travel
 {
 
-extern std::vector<map_data> map_list;
+extern thread_local std::vector<map_data> map_list;
 
 void init();
+void cleanup();
 
 void store_to_save_lines(std::vector<std::string>& lines);
 void setup_from_save_lines(std::vector<std::string>& lines);
 
 void try_use_down_stairs();
 
+//Starts making the layout of the next level on a worker thread, if it is a standard
+//level and this is not done already. Call this at a fixed point of the game (it draws a
+//random number for the worker's seed). Going to the next level uses the layout, however
+//the player gets there.
+void prefetch_nxt_lvl();
+
 void go_to_nxt();
 
+//Type of the current level
 Map_type map_type();
 
+//Totals for all levels built since the program started (for statistics). The time is
+//what was spent on this thread - for layouts made by the worker, waiting for the worker
+//and populating the layout.
+long nr_lvl_build_attempts();
+double lvl_build_seconds();
+
 } //map_travel
 
 #endif
@@ -146,7 +146,7 @@ inline MTRand::uint32 MTRand::hash(time_t t, clock_t c)
     // Better than uint32(x) in case x is floating point in [0,1]
     // Based on code by Lawrence Kirby (fred@genesis.demon.co.uk)
 
-    static uint32 differ = 0;  // guarantee time-based seeds will change
+    static thread_local uint32 differ = 0;  // guarantee time-based seeds will change
 
     uint32 h1 = 0;
     unsigned char* p = (unsigned char*) &t;
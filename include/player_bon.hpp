@@ -61,7 +61,7 @@ enum class Bg {occultist, rogue, war_vet, END};
 namespace player_bon
 {
 
-extern bool traits[int(Trait::END)];
+extern thread_local bool traits[int(Trait::END)];
 
 void init();
 
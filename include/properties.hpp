@@ -128,7 +128,7 @@ struct Prop_data_t
 namespace prop_data
 {
 
-extern Prop_data_t data[size_t(Prop_id::END)];
+extern thread_local Prop_data_t data[size_t(Prop_id::END)];
 
 void init();
 
@@ -174,6 +174,8 @@ public:
 
     void prop_ids(bool out[size_t(Prop_id::END)]) const;
 
+    bool has_prop(const Prop_id id) const;
+
     Prop* prop(const Prop_id id, const Prop_src source) const;
 
     bool end_applied_prop(const Prop_id id, const bool RUN_PROP_END_EFFECTS = true);
@@ -197,18 +199,19 @@ public:
     bool try_resist_dmg(const Dmg_type dmg_type, const bool ALLOW_MSG) const;
 
 private:
-    //These two functions are responsible for collecting properties from all possible
-    //specified sources. They must be "mirrored" in that they collect information from
-    //exactly the same places - except one will return a list of Props, and the other
-    //will return a list of Prop_ids. This is an optimization. The reasoning is that in
-    //many cases (such as the very frequent Actor::add_light) it is sufficient to know
-    //the ids. It would then be wasteful to first gather all Props, then gather the ids
-    //from those. It's more efficient to just gather the ids at once.
     void props_from_sources(std::vector<Prop*>& out,
                             bool sources[int(Prop_src::END)]) const;
 
-    void prop_ids_from_sources(bool out[size_t(Prop_id::END)],
-                               bool sources[int(Prop_src::END)]) const;
+    //The properties from all sources, and their ids, are cached since they are queried
+    //very frequently (e.g. by Actor::lgt_size for every actor when updating the light
+    //map). The cache is invalidated when a property is applied or ended, and when any
+    //inventory changes (see Inventory::revision).
+    const std::vector<Prop*>& all_props() const;
+
+    mutable std::vector<Prop*> all_props_cache_;
+    mutable bool prop_ids_cache_[size_t(Prop_id::END)];
+    mutable bool is_cache_dirty_;
+    mutable int cache_inv_revision_;
 
     bool try_resist_prop(const Prop_id id, const std::vector<Prop*>& prop_list) const;
 
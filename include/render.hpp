@@ -24,8 +24,8 @@ enum class Panel
 namespace render
 {
 
-extern Cell_render_data render_array[MAP_W][MAP_H];
-extern Cell_render_data render_array_no_actors[MAP_W][MAP_H];
+extern thread_local Cell_render_data render_array[MAP_W][MAP_H];
+extern thread_local Cell_render_data render_array_no_actors[MAP_W][MAP_H];
 
 void init();
 void cleanup();
@@ -34,6 +34,10 @@ void draw_map_and_interface(const bool SHOULD_UPDATE_SCREEN = true);
 
 void update_screen();
 
+//Writes the drawn screen to a PPM image (only with the "sdl" or "mem" render backends),
+//returns false if the file could not be written
+bool save_ppm(const std::string& file_path);
+
 void clear_screen();
 
 void draw_tile(const Tile_id tile, const Panel panel, const Pos& pos,
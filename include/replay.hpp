@@ -0,0 +1,34 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <string>
+
+struct Key_data;
+
+//Records the random seed and all keys read by input::input() to a file, and plays such a
+//file back instead of reading the keyboard - so that the exact same session can be run
+//again (e.g. to profile a heavy scenario repeatedly). A replay only reproduces a session
+//if the game starts in the same state, i.e. with the same options and the same save file
+//(if the recorded session loaded a game).
+namespace replay
+{
+
+//Writes the file header with the given seed - call this after seeding rnd
+bool start_recording(const std::string& path, const unsigned long SEED);
+
+//Reads the seed from the file header, the caller seeds rnd with it
+bool start_playback(const std::string& path, unsigned long& seed_ref);
+
+void cleanup();
+
+bool is_playing();
+
+//Gets the next recorded key. Returns false when the replay has ended (playback is then
+//stopped, and input is read from the keyboard again).
+bool next_key(Key_data& d);
+
+void on_key_read(const Key_data& d);
+
+} //replay
+
+#endif
@@ -2,6 +2,7 @@
 #define UTILS_H
 
 #include <vector>
+#include <algorithm>
 
 #include "cmn_data.hpp"
 #include "cmn_types.hpp"
@@ -9,15 +10,19 @@
 
 class Actor;
 class Mob;
+class Map_bits;
 
 namespace rnd
 {
 
 //NOTE: If MTRand is not provided any parameters to the constructor, it will be seeded
-//with current time. So seeding it manually is not necessary for normal gameplay
-//purposes - only if seed should be controlled.
+//with current time. The game seeds it explicitly at startup however (and logs the seed),
+//so that a session can be reproduced.
 void seed(const unsigned long val);
 
+//The last value passed to seed()
+unsigned long cur_seed();
+
 int dice(const int ROLLS, const int SIDES);
 
 int dice(const Dice_param& p);
@@ -38,6 +43,18 @@ int percent();
 
 bool percent(const int PCT_CHANCE);
 
+//Use this instead of std::random_shuffle, which draws from its own (unseeded) generator
+template<typename Iter>
+void shuffle(Iter first, Iter last)
+{
+    const int N = last - first;
+
+    for (int i = N - 1; i > 0; --i)
+    {
+        std::iter_swap(first + i, first + range(0, i));
+    }
+}
+
 } //rnd
 
 enum class Time_type
@@ -94,8 +111,12 @@ template<typename T> void reset_array(T* a[MAP_W][MAP_H])
 
 void reverse_bool_array(bool array[MAP_W][MAP_H]);
 
+void reverse_bool_array(Map_bits& array);
+
 void copy_bool_array(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H]);
 
+void copy_bool_array(const Map_bits& in, Map_bits& out);
+
 void mk_vector_from_bool_map(const bool VALUE_TO_STORE, const bool a[MAP_W][MAP_H],
                              std::vector<Pos>& out);
 
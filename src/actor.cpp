@@ -1,5 +1,7 @@
 #include "actor.hpp"
 
+#include <unordered_map>
+
 #include "init.hpp"
 
 #include "render.hpp"
@@ -8,6 +10,7 @@
 #include "actor_mon.hpp"
 #include "map.hpp"
 #include "fov.hpp"
+#include "map_bits.hpp"
 #include "msg_log.hpp"
 #include "feature_trap.hpp"
 #include "drop.hpp"
@@ -78,6 +81,54 @@ int Actor::hp_max(const bool WITH_MODIFIERS) const
     return WITH_MODIFIERS ? prop_handler_->changed_max_hp(hp_max_) : hp_max_;
 }
 
+namespace
+{
+
+//Results of monsters checking line of sight to other actors (see can_see_actor). These
+//only depend on the positions, and on which cells block line of sight or are lit or dark,
+//so repeated checks between the same positions are free until the map obstruction layers
+//or the light map change. (Dark cells are only set during map generation.)
+thread_local unordered_map<int, bool>    los_cache_;
+thread_local int                         los_cache_obstr_revision_   = -1;
+thread_local int                         los_cache_light_revision_   = -1;
+
+bool is_los_to_actor(const bool blocked_los[MAP_W][MAP_H], const Pos& origin,
+                     const Pos& tgt, const bool IS_AFFECTED_BY_DARKNESS)
+{
+    if (
+        los_cache_obstr_revision_ != map::obstr_revision() ||
+        los_cache_light_revision_ != game_time::light_map_revision())
+    {
+        los_cache_.clear();
+
+        los_cache_obstr_revision_ = map::obstr_revision();
+        los_cache_light_revision_ = game_time::light_map_revision();
+    }
+
+    const int NR_CELLS = MAP_W * MAP_H;
+
+    const int KEY = (((origin.x * MAP_H + origin.y) * NR_CELLS) + (tgt.x * MAP_H + tgt.y)) * 2 +
+                    (IS_AFFECTED_BY_DARKNESS ? 1 : 0);
+
+    const auto it = los_cache_.find(KEY);
+
+    if (it != end(los_cache_))
+    {
+        //The blocking array is expected to be the line of sight blocking cells
+        assert(it->second == fov::check_cell(blocked_los, tgt, origin,
+                                             IS_AFFECTED_BY_DARKNESS));
+        return it->second;
+    }
+
+    const bool IS_LOS = fov::check_cell(blocked_los, tgt, origin, IS_AFFECTED_BY_DARKNESS);
+
+    los_cache_[KEY] = IS_LOS;
+
+    return IS_LOS;
+}
+
+} //namespace
+
 Actor_speed Actor::speed() const
 {
     const auto base_speed = data_->speed;
@@ -152,7 +203,7 @@ bool Actor::can_see_actor(const Actor& other, const bool blocked_los[MAP_W][MAP_
 
     if (blocked_los)
     {
-        return fov::check_cell(blocked_los, other.pos, pos, !data_->can_see_in_darkness);
+        return is_los_to_actor(blocked_los, pos, other.pos, !data_->can_see_in_darkness);
     }
 
     return false;
@@ -229,6 +280,15 @@ void Actor::place(const Pos& pos_, Actor_data_t& actor_data)
     update_clr();
 }
 
+void Actor::set_pos(const Pos& new_pos)
+{
+    const Pos old_pos = pos;
+
+    pos = new_pos;
+
+    game_time::on_actor_moved(*this, old_pos);
+}
+
 void Actor::teleport()
 {
     bool blocked[MAP_W][MAP_H];
@@ -325,7 +385,7 @@ void Actor::teleport()
         static_cast<Mon*>(this)->player_aware_of_me_counter_ = 0;
     }
 
-    pos = tgt_pos;
+    set_pos(tgt_pos);
 
     if (is_player())
     {
@@ -621,6 +681,7 @@ Actor_died Actor::hit(int dmg, const Dmg_type dmg_type, Dmg_method method)
                     delete armor;
                     armor = nullptr;
                     inv_->slots_[int(Slot_id::body)].item = nullptr;
+                    Inventory::on_changed();
                 }
             }
         }
@@ -796,7 +857,7 @@ void Actor::die(const bool IS_DESTROYED, const bool ALLOW_GORE,
 
                         if (feature_here->can_have_corpse())
                         {
-                            pos.set(new_pos);
+                            set_pos(new_pos);
                             dx = 9999;
                             dy = 9999;
                         }
@@ -824,58 +885,22 @@ void Actor::die(const bool IS_DESTROYED, const bool ALLOW_GORE,
     render::draw_map_and_interface();
 }
 
-void Actor::add_light(bool light_map[MAP_W][MAP_H]) const
+Lgt_size Actor::lgt_size() const
 {
-    bool props[size_t(Prop_id::END)];
-    prop_handler_->prop_ids(props);
+    Lgt_size size = Lgt_size::none;
 
-    if (state_ == Actor_state::alive && props[int(Prop_id::radiant)])
+    if (state_ == Actor_state::alive && prop_handler_->has_prop(Prop_id::radiant))
     {
-        //TODO: Much of the code below is duplicated from Actor_player::add_light_(), some
-        //refactoring is needed.
-
-        bool my_light[MAP_W][MAP_H];
-        utils::reset_array(my_light, false);
-        const int RADI = FOV_STD_RADI_INT;
-        Pos p0(max(0, pos.x - RADI), max(0, pos.y - RADI));
-        Pos p1(min(MAP_W - 1, pos.x + RADI), min(MAP_H - 1, pos.y + RADI));
-
-        bool blocked_los[MAP_W][MAP_H];
-
-        for (int y = p0.y; y <= p1.y; ++y)
-        {
-            for (int x = p0.x; x <= p1.x; ++x)
-            {
-                const auto* const f = map::cells[x][y].rigid;
-                blocked_los[x][y]    = !f->is_los_passable();
-            }
-        }
-
-        fov::run_fov_on_array(blocked_los, pos, my_light, false);
-
-        for (int y = p0.y; y <= p1.y; ++y)
-        {
-            for (int x = p0.x; x <= p1.x; ++x)
-            {
-                if (my_light[x][y])
-                {
-                    light_map[x][y] = true;
-                }
-            }
-        }
+        size = Lgt_size::fov;
     }
-    else if (props[int(Prop_id::burning)])
+    else if (prop_handler_->has_prop(Prop_id::burning))
     {
-        for (int dx = -1; dx <= 1; ++dx)
-        {
-            for (int dy = -1; dy <= 1; ++dy)
-            {
-                light_map[pos.x + dx][pos.y + dy] = true;
-            }
-        }
+        size = Lgt_size::small;
     }
 
-    add_light_(light_map);
+    const Lgt_size own_size = lgt_size_();
+
+    return int(own_size) > int(size) ? own_size : size;
 }
 
 bool Actor::is_player() const
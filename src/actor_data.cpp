@@ -70,7 +70,7 @@ void Actor_data_t::reset()
 namespace actor_data
 {
 
-Actor_data_t data[int(Actor_id::END)];
+thread_local Actor_data_t data[int(Actor_id::END)];
 
 namespace
 {
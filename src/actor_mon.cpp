@@ -27,6 +27,7 @@
 #include "knockback.hpp"
 #include "explosion.hpp"
 #include "popup.hpp"
+#include "config.hpp"
 
 using namespace std;
 
@@ -86,6 +87,33 @@ void Mon::on_actor_turn()
         waiting_ = false;
     }
 
+    //------------------------------ DORMANT MONSTERS
+    if (is_dormant())
+    {
+        tgt_ = nullptr;
+
+        if (spell_cool_down_cur_ != 0) {spell_cool_down_cur_--;}
+
+        is_stealth_ = data_->ability_vals.val(Ability_id::stealth, true, *this) > 0 &&
+                      !map::player->can_see_actor(*this, nullptr);
+
+        if (on_actor_turn_())
+        {
+            return;
+        }
+
+        if (data_->ai[int(Ai_id::moves_to_random_when_unaware)])
+        {
+            if (ai::action::move_to_random_adj_cell(*this))
+            {
+                return;
+            }
+        }
+
+        game_time::tick();
+        return;
+    }
+
     //Pick a target
     vector<Actor*> tgt_bucket;
 
@@ -396,7 +424,7 @@ void Mon::move_dir(Dir dir)
 
     if (dir != Dir::center && utils::is_pos_inside_map(tgt_cell, false))
     {
-        pos = tgt_cell;
+        set_pos(tgt_cell);
 
         //Bump features in target cell (i.e. to trigger traps)
         vector<Mob*> mobs;
@@ -638,6 +666,54 @@ Ai_att_data Mon::choose_att(const Ai_avail_attacks_data& mon_avail_attacks)
     return att;
 }
 
+bool Mon::is_dormant() const
+{
+    const int DORMANT_DIST = config::mon_dormant_dist();
+
+    if (
+        DORMANT_DIST <= 0                   ||
+        aware_counter_ > 0                  ||
+        is_actor_my_leader(map::player)     ||
+        prop_handler_->has_prop(Prop_id::conflict))
+    {
+        return false;
+    }
+
+    if (map::cells[pos.x][pos.y].is_lit)
+    {
+        return false;
+    }
+
+    if (map::player->is_alive() && utils::king_dist(pos, map::player->pos) <= DORMANT_DIST)
+    {
+        return false;
+    }
+
+    //The player is out of range - look for the player's allies in range, through the
+    //position index (this is called for each monster each turn, so all actors should not
+    //be iterated here)
+    const int X0 = max(0,         pos.x - DORMANT_DIST);
+    const int Y0 = max(0,         pos.y - DORMANT_DIST);
+    const int X1 = min(MAP_W - 1, pos.x + DORMANT_DIST);
+    const int Y1 = min(MAP_H - 1, pos.y + DORMANT_DIST);
+
+    for (int x = X0; x <= X1; ++x)
+    {
+        for (int y = Y0; y <= Y1; ++y)
+        {
+            for (const Actor* const actor : game_time::actors_at_pos(Pos(x, y)))
+            {
+                if (map::player->is_leader_of(actor) && actor->is_alive())
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
 bool Mon::is_leader_of(const Actor* const actor) const
 {
     if (!actor || actor->is_player())
@@ -1933,7 +2009,13 @@ bool The_high_priest::on_actor_turn_()
 
             if (i == 0)
             {
-                pos.swap(mon->pos);
+                //Swap positions with the copy (the position index allows several actors
+                //in a cell, so no free cell is needed in between)
+                const Pos priest_pos = pos;
+
+                set_pos(mon->pos);
+                mon->set_pos(priest_pos);
+
                 assert(pos != mon->pos);
             }
         }
@@ -18,6 +18,7 @@
 #include "query.hpp"
 #include "attack.hpp"
 #include "fov.hpp"
+#include "map_bits.hpp"
 #include "item_factory.hpp"
 #include "actor_factory.hpp"
 #include "player_bon.hpp"
@@ -33,6 +34,7 @@
 #include "item_potion.hpp"
 #include "text_format.hpp"
 #include "utils.hpp"
+#include "map_travel.hpp"
 
 using namespace std;
 
@@ -133,6 +135,7 @@ void Player::mk_start_items()
         auto* const dagger = item_factory::mk(Item_id::dagger);
         static_cast<Wpn*>(dagger)->melee_dmg_plus_ = 1;
         inv_->slots_[int(Slot_id::wielded)].item = dagger;
+        Inventory::on_changed();
 
         //Rogue starts with some iron spikes (useful tool)
         inv_->put_in_general(item_factory::mk(Item_id::iron_spike, 8));
@@ -260,10 +263,12 @@ void Player::setup_from_save_lines(vector<string>& lines)
     lines.erase(begin(lines));
     spi_max_ = to_int(lines.front());
     lines.erase(begin(lines));
-    pos.x = to_int(lines.front());
+    Pos saved_pos;
+    saved_pos.x = to_int(lines.front());
     lines.erase(begin(lines));
-    pos.y = to_int(lines.front());
+    saved_pos.y = to_int(lines.front());
     lines.erase(begin(lines));
+    set_pos(saved_pos);
 
     for (int i = 0; i < int(Ability_id::END); ++i)
     {
@@ -958,6 +963,10 @@ void Player::on_actor_turn()
         }
     }
 
+    //Start making the next level on a worker thread (if not started already). This is a
+    //fixed point of the game, so seeded sessions and replays get the same levels.
+    map_travel::prefetch_nxt_lvl();
+
     //If this point is reached - read input from player
     if (config::is_bot_playing())
     {
@@ -1461,10 +1470,10 @@ void Player::move_dir(Dir dir)
                 if (mon_at_dest && is_leader_of(mon_at_dest))
                 {
                     msg_log::add("I displace " + mon_at_dest->name_a() + ".");
-                    mon_at_dest->pos = pos;
+                    mon_at_dest->set_pos(pos);
                 }
 
-                pos = dest;
+                set_pos(dest);
 
                 const int FREE_MOVE_EVERY_N_TURN =
                     player_bon::traits[int(Trait::mobile)]     ? 2 :
@@ -1576,7 +1585,7 @@ void Player::punch_mon(Actor& actor_to_punch)
     delete punch_wpn;
 }
 
-void Player::add_light_(bool light_map[MAP_W][MAP_H]) const
+Lgt_size Player::lgt_size_() const
 {
     Lgt_size lgt_size = Lgt_size::none;
 
@@ -1601,59 +1610,7 @@ void Player::add_light_(bool light_map[MAP_W][MAP_H]) const
         }
     }
 
-    switch (lgt_size)
-    {
-    case Lgt_size::fov:
-    {
-        bool my_light[MAP_W][MAP_H];
-        utils::reset_array(my_light, false);
-
-        const int R = FOV_STD_RADI_INT;
-
-        Pos p0(max(0,         pos.x - R), max(0,         pos.y - R));
-        Pos p1(min(MAP_W - 1, pos.x + R), min(MAP_H - 1, pos.y + R));
-
-        bool blocked_los[MAP_W][MAP_H];
-
-        for (int y = p0.y; y <= p1.y; ++y)
-        {
-            for (int x = p0.x; x <= p1.x; ++x)
-            {
-                const auto* const f = map::cells[x][y].rigid;
-                blocked_los[x][y]    = !f->is_los_passable();
-            }
-        }
-
-        fov::run_fov_on_array(blocked_los, pos, my_light, false);
-
-        for (int y = p0.y; y <= p1.y; ++y)
-        {
-            for (int x = p0.x; x <= p1.x; ++x)
-            {
-                if (my_light[x][y])
-                {
-                    light_map[x][y] = true;
-                }
-            }
-        }
-
-    }
-    break;
-
-    case Lgt_size::small:
-        for (int y = pos.y - 1; y <= pos.y + 1; ++y)
-        {
-            for (int x = pos.x - 1; x <= pos.x + 1; ++x)
-            {
-                light_map[x][y] = true;
-            }
-        }
-
-        break;
-
-    case Lgt_size::none: {}
-        break;
-    }
+    return lgt_size;
 }
 
 void Player::update_fov()
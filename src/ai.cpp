@@ -1,5 +1,8 @@
 #include "ai.hpp"
 
+#include <algorithm>
+#include <climits>
+
 #include "actor_player.hpp"
 #include "msg_log.hpp"
 #include "map.hpp"
@@ -11,6 +14,7 @@
 #include "map_parsing.hpp"
 #include "game_time.hpp"
 #include "fov.hpp"
+#include "feature_data.hpp"
 
 using namespace std;
 
@@ -33,7 +37,7 @@ bool try_cast_random_spell(Mon& mon)
 
     vector<Spell*> spell_bucket = mon.spells_known_;
 
-    std::random_shuffle(begin(spell_bucket), end(spell_bucket));
+    rnd::shuffle(begin(spell_bucket), end(spell_bucket));
 
     while (!spell_bucket.empty())
     {
@@ -583,14 +587,157 @@ void set_path_to_leader_if_no_los_toleader(Mon& mon, vector<Pos>& path)
     path.clear();
 }
 
-void set_path_to_player_if_aware(Mon& mon, vector<Pos>& path)
+namespace
 {
-    if (!mon.is_alive() || mon.aware_counter_ <= 0)
+
+//Distance to the player from each cell, for one way of moving (i.e. the properties which
+//allow moving through some features, and if doors can be passed). Instead of every
+//monster running its own path search towards the player, the fields are shared by all
+//monsters moving the same way, and rebuilt when the player moves or the map changes.
+struct Player_dist_field
+{
+    bool    move_props[size_t(Prop_id::END)];
+    bool    is_passing_doors;
+    int     dist[MAP_W][MAP_H];
+};
+
+//NOTE: Fields are reused when invalidated (only the first "nr_player_dist_fields_" are
+//valid), so that they are not reallocated every turn
+thread_local vector<Player_dist_field>   player_dist_fields_;
+thread_local size_t                      nr_player_dist_fields_      = 0;
+thread_local Pos                         player_dist_fields_pos_     = Pos(-1, -1);
+thread_local int                         player_dist_fields_revision_ = -1;
+
+thread_local bool    move_relevant_props_[size_t(Prop_id::END)];
+thread_local bool    is_move_relevant_props_set_ = false;
+
+void set_move_relevant_props()
+{
+    for (size_t i = 0; i < size_t(Prop_id::END); ++i)
     {
-        path.clear();
-        return;
+        bool& is_relevant = move_relevant_props_[i];
+
+        is_relevant = false;
+
+        for (int feature_id = 0; feature_id < int(Feature_id::END); ++feature_id)
+        {
+            const Move_rules& rules = feature_data::data(Feature_id(feature_id)).move_rules;
+
+            if (rules.can_move_if_have_prop(Prop_id(i)))
+            {
+                is_relevant = true;
+                break;
+            }
+        }
+    }
+
+    //Closed doors can also be passed with these (see Door::can_move)
+    move_relevant_props_[size_t(Prop_id::ethereal)]   = true;
+    move_relevant_props_[size_t(Prop_id::ooze)]       = true;
+
+    is_move_relevant_props_set_ = true;
+}
+
+void mk_player_dist_field(Player_dist_field& field)
+{
+    bool blocked[MAP_W][MAP_H];
+    utils::reset_array(blocked, false);
+
+    const int X0 = 1;
+    const int Y0 = 1;
+    const int X1 = MAP_W - 1;
+    const int Y1 = MAP_H - 1;
+
+    for (int x = X0; x < X1; ++x)
+    {
+        for (int y = Y0; y < Y1; ++y)
+        {
+            const auto* const f = map::cells[x][y].rigid;
+
+            if (!f->can_move(field.move_props))
+            {
+                if (f->id() == Feature_id::door)
+                {
+                    const Door* const door = static_cast<const Door*>(f);
+
+                    if (!field.is_passing_doors || door->is_handled_externally())
+                    {
+                        blocked[x][y] = true;
+                    }
+                }
+                else //Not a door
+                {
+                    blocked[x][y] = true;
+                }
+            }
+        }
+    }
+
+    flood_fill::run(map::player->pos, blocked, field.dist, 10000, Pos(-1, -1), true);
+}
+
+const Player_dist_field& player_dist_field(Mon& mon)
+{
+    if (
+        player_dist_fields_pos_         != map::player->pos ||
+        player_dist_fields_revision_    != map::obstr_revision())
+    {
+        nr_player_dist_fields_          = 0;
+        player_dist_fields_pos_         = map::player->pos;
+        player_dist_fields_revision_    = map::obstr_revision();
+    }
+
+    if (!is_move_relevant_props_set_)
+    {
+        set_move_relevant_props();
+    }
+
+    bool move_props[size_t(Prop_id::END)];
+    mon.prop_handler().prop_ids(move_props);
+
+    for (size_t i = 0; i < size_t(Prop_id::END); ++i)
+    {
+        move_props[i] = move_props[i] && move_relevant_props_[i];
+    }
+
+    const Actor_data_t& d = mon.data();
+
+    const bool IS_PASSING_DOORS = d.can_open_doors || d.can_bash_doors;
+
+    for (size_t i = 0; i < nr_player_dist_fields_; ++i)
+    {
+        const Player_dist_field& field = player_dist_fields_[i];
+
+        if (
+            field.is_passing_doors == IS_PASSING_DOORS &&
+            equal(begin(move_props), end(move_props), begin(field.move_props)))
+        {
+            return field;
+        }
     }
 
+    //No field for this way of moving yet
+    if (nr_player_dist_fields_ == player_dist_fields_.size())
+    {
+        player_dist_fields_.push_back(Player_dist_field());
+    }
+
+    Player_dist_field& field = player_dist_fields_[nr_player_dist_fields_];
+
+    ++nr_player_dist_fields_;
+
+    copy(begin(move_props), end(move_props), begin(field.move_props));
+
+    field.is_passing_doors = IS_PASSING_DOORS;
+
+    mk_player_dist_field(field);
+
+    return field;
+}
+
+//Path search for the monster alone, with living actors next to it treated as blocking
+void set_own_path_to_player(Mon& mon, vector<Pos>& path)
+{
     bool blocked[MAP_W][MAP_H];
     utils::reset_array(blocked, false);
 
@@ -638,6 +785,113 @@ void set_path_to_player_if_aware(Mon& mon, vector<Pos>& path)
     path_find::run(mon.pos, map::player->pos, blocked, path);
 }
 
+} //namespace
+
+void set_path_to_player_if_aware(Mon& mon, vector<Pos>& path)
+{
+    path.clear();
+
+    if (!mon.is_alive() || mon.aware_counter_ <= 0)
+    {
+        return;
+    }
+
+    const Pos& player_pos = map::player->pos;
+
+    if (utils::is_pos_adj(mon.pos, player_pos, false))
+    {
+        //The player is a living actor next to the monster, so the target is blocked
+        return;
+    }
+
+    const Player_dist_field& field = player_dist_field(mon);
+
+    //Living actors next to the monster block the first step
+    Pos adj_actors[8];
+    size_t nr_adj_actors = 0;
+
+    for (const Actor* const actor : game_time::actors_)
+    {
+        if (
+            actor->is_alive() &&
+            utils::is_pos_adj(mon.pos, actor->pos, false) &&
+            nr_adj_actors < 8)
+        {
+            adj_actors[nr_adj_actors++] = actor->pos;
+        }
+    }
+
+    //Walk down the distance field to the player (a distance of zero means not reached)
+    Pos cur_pos(mon.pos);
+    int cur_dist = field.dist[cur_pos.x][cur_pos.y];
+
+    if (cur_dist == 0)
+    {
+        cur_dist = INT_MAX;
+    }
+
+    while (true)
+    {
+        const bool IS_FIRST_STEP = path.empty();
+
+        Pos next_pos(-1, -1);
+        int next_dist = cur_dist;
+
+        bool is_blocked_by_actor = false;
+
+        for (const Pos& d : dir_utils::dir_list)
+        {
+            const Pos adj_pos(cur_pos + d);
+
+            if (adj_pos == player_pos)
+            {
+                path.push_back(adj_pos);
+
+                //The path goes from target to origin
+                reverse(begin(path), end(path));
+                return;
+            }
+
+            const int ADJ_DIST = field.dist[adj_pos.x][adj_pos.y];
+
+            if (ADJ_DIST == 0 || ADJ_DIST >= next_dist)
+            {
+                continue;
+            }
+
+            if (
+                IS_FIRST_STEP &&
+                find(adj_actors, adj_actors + nr_adj_actors, adj_pos) !=
+                adj_actors + nr_adj_actors)
+            {
+                is_blocked_by_actor = true;
+                continue;
+            }
+
+            next_pos    = adj_pos;
+            next_dist   = ADJ_DIST;
+        }
+
+        if (next_dist == cur_dist)
+        {
+            //No step closer to the player
+            if (is_blocked_by_actor)
+            {
+                //All steps closer are blocked by other actors - try to find a way
+                //around them
+                set_own_path_to_player(mon, path);
+            }
+
+            return;
+        }
+
+        path.push_back(next_pos);
+
+        cur_pos     = next_pos;
+        cur_dist    = next_dist;
+    }
+}
+
 void set_special_blocked_cells(Mon& mon, bool a[MAP_W][MAP_H])
 {
     (void)mon;
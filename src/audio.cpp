@@ -85,7 +85,8 @@ void init()
 
     cleanup();
 
-    if (config::is_audio_enabled())
+    //Without a window (e.g. headless bot games) there is nobody to play any sounds for
+    if (config::is_audio_enabled() && config::render_backend() == Render_backend::sdl)
     {
         audio_chunks.resize(int(Sfx_id::END));
 
@@ -242,18 +243,21 @@ void play(const Sfx_id sfx, const Dir dir, const int DISTANCE_PERCENT)
 
 void try_play_amb(const int ONE_IN_N_CHANCE_TO_PLAY)
 {
-    if (!audio_chunks.empty() && rnd::one_in(ONE_IN_N_CHANCE_TO_PLAY))
+    //NOTE: The random numbers are drawn regardless of the time and if audio is loaded,
+    //otherwise the rest of the game would not play out the same from a given seed
+    if (rnd::one_in(ONE_IN_N_CHANCE_TO_PLAY))
     {
+        const int   VOL_PERCENT = rnd::one_in(5) ? rnd::range(50,  99) : 100;
+        const int   FIRST_INT   = int(Sfx_id::AMB_START) + 1;
+        const int   LAST_INT    = int(Sfx_id::AMB_END)   - 1;
+        const Sfx_id sfx         = Sfx_id(rnd::range(FIRST_INT, LAST_INT));
+
         const int TIME_NOW                  = time(nullptr);
         const int TIME_REQ_BETWEEN_AMB_SFX  = 20;
 
-        if ((TIME_NOW - TIME_REQ_BETWEEN_AMB_SFX) > time_at_last_amb_)
+        if (!audio_chunks.empty() && (TIME_NOW - TIME_REQ_BETWEEN_AMB_SFX) > time_at_last_amb_)
         {
-            time_at_last_amb_          = TIME_NOW;
-            const int   VOL_PERCENT = rnd::one_in(5) ? rnd::range(50,  99) : 100;
-            const int   FIRST_INT   = int(Sfx_id::AMB_START) + 1;
-            const int   LAST_INT    = int(Sfx_id::AMB_END)   - 1;
-            const Sfx_id sfx         = Sfx_id(rnd::range(FIRST_INT, LAST_INT));
+            time_at_last_amb_ = TIME_NOW;
             play(sfx , VOL_PERCENT);
         }
     }
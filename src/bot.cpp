@@ -15,6 +15,7 @@
 #include "actor_factory.hpp"
 #include "attack.hpp"
 #include "feature_door.hpp"
+#include "feature_mob.hpp"
 #include "inventory.hpp"
 #include "actor_mon.hpp"
 #include "map_parsing.hpp"
@@ -30,7 +31,10 @@ namespace bot
 namespace
 {
 
-std::vector<Pos> cur_path_;
+thread_local std::vector<Pos> cur_path_;
+
+thread_local int max_dlvl_           = DLVL_LAST;
+thread_local int nr_runs_finished_   = 0;
 
 void find_path_to_stairs()
 {
@@ -67,6 +71,82 @@ void find_path_to_stairs()
     assert(cur_path_.front() == stair_pos);
 }
 
+#ifndef NDEBUG
+//Compares the map obstruction layers against the cell checks they are caching
+void assert_obstr_layers_in_sync()
+{
+    const cell_check::Blocks_los          blocks_los;
+    const cell_check::Blocks_move_cmn     blocks_move(false);
+    const cell_check::Blocks_projectiles  blocks_proj;
+
+    const Map_bits& los_layer   = map::obstr_layer(Obstr_layer::los);
+    const Map_bits& move_layer  = map::obstr_layer(Obstr_layer::move_cmn);
+    const Map_bits& proj_layer  = map::obstr_layer(Obstr_layer::projectiles);
+    const Map_bits& snd_layer   = map::obstr_layer(Obstr_layer::sound);
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const Cell& cell = map::cells[x][y];
+
+            bool is_blocking_los  = blocks_los.check(cell);
+            bool is_blocking_move = blocks_move.check(cell);
+            bool is_blocking_proj = blocks_proj.check(cell);
+
+            for (const Mob* const mob : game_time::mobs_)
+            {
+                if (mob->pos() == cell.pos)
+                {
+                    is_blocking_los  = is_blocking_los  || blocks_los.check(*mob);
+                    is_blocking_move = is_blocking_move || blocks_move.check(*mob);
+                    is_blocking_proj = is_blocking_proj || blocks_proj.check(*mob);
+                }
+            }
+
+            assert(los_layer.at(x, y)   == is_blocking_los);
+            assert(move_layer.at(x, y)  == is_blocking_move);
+            assert(proj_layer.at(x, y)  == is_blocking_proj);
+
+            const bool IS_BLOCKING_SND =
+                !utils::is_pos_inside_map(cell.pos, false) || !cell.rigid->is_sound_passable();
+
+            assert(snd_layer.at(x, y)   == IS_BLOCKING_SND);
+        }
+    }
+}
+
+//Checks that the actor and mob position index contains exactly the actors and mobs
+void assert_pos_index_in_sync()
+{
+    size_t nr_actors_indexed = 0;
+    size_t nr_mobs_indexed   = 0;
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const Pos p(x, y);
+
+            for (const Actor* const actor : game_time::actors_at_pos(p))
+            {
+                assert(actor->pos == p);
+                ++nr_actors_indexed;
+            }
+
+            for (const Mob* const mob : game_time::mobs_at_pos(p))
+            {
+                assert(mob->pos() == p);
+                ++nr_mobs_indexed;
+            }
+        }
+    }
+
+    assert(nr_actors_indexed == game_time::actors_.size());
+    assert(nr_mobs_indexed   == game_time::mobs_.size());
+}
+#endif // NDEBUG
+
 bool walk_to_adj_cell(const Pos& p)
 {
     assert(utils::is_pos_adj(map::player->pos, p, true));
@@ -86,6 +166,8 @@ bool walk_to_adj_cell(const Pos& p)
 void init()
 {
     cur_path_.clear();
+
+    nr_runs_finished_ = 0;
 }
 
 void act()
@@ -102,6 +184,11 @@ void act()
 #endif
     }
 
+#ifndef NDEBUG
+    assert_obstr_layers_in_sync();
+    assert_pos_index_in_sync();
+#endif
+
     //=======================================================================
 
     //Abort?
@@ -112,8 +199,10 @@ void act()
 //    }
 
     //Check if we are finished with the current run, if so, go back to DLVL 1
-    if (map::dlvl >= DLVL_LAST)
+    if (map::dlvl >= max_dlvl_)
     {
+        ++nr_runs_finished_;
+
         TRACE << "Starting new run on first dungeon level" << endl;
         map_travel::init();
         map::dlvl = 1;
@@ -228,4 +317,16 @@ void act()
     walk_to_adj_cell(cur_path_.back());
 }
 
+void set_max_dlvl(const int DLVL)
+{
+    assert(DLVL >= 1 && DLVL <= DLVL_LAST);
+
+    max_dlvl_ = DLVL;
+}
+
+int nr_runs_finished()
+{
+    return nr_runs_finished_;
+}
+
 } //Bot
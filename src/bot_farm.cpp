@@ -0,0 +1,807 @@
+#include "bot_farm.hpp"
+
+#include "init.hpp"
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <chrono>
+#include <csignal>
+
+#include <SDL_thread.h>
+#include <SDL_atomic.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#include <sys/wait.h>
+#endif // _WIN32
+
+#include "config.hpp"
+#include "bot.hpp"
+#include "player_bon.hpp"
+#include "create_character.hpp"
+#include "actor_player.hpp"
+#include "map.hpp"
+#include "map_travel.hpp"
+#include "game_time.hpp"
+#include "utils.hpp"
+#include "render.hpp"
+
+using namespace std;
+
+namespace bot_farm
+{
+
+namespace
+{
+
+struct Worker_result
+{
+    Worker_result() :
+        seed                    (0),
+        is_ok                   (false),
+        mon_dormant_dist        (0),
+        nr_runs_finished        (0),
+        nr_deaths               (0),
+        nr_turns                (0),
+        nr_lvls                 (0),
+        nr_lvl_build_attempts   (0),
+        seconds                 (0.0),
+        seconds_lvl_build       (0.0),
+        seconds_player          (0.0),
+        seconds_mon             (0.0),
+        nr_turns_on_dlvl        (DLVL_LAST + 1, 0) {}
+
+    unsigned long   seed;
+    bool            is_ok;                  //False if the worker crashed or failed an assert
+    int             mon_dormant_dist;
+    int             nr_runs_finished;
+    int             nr_deaths;
+    long            nr_turns;
+    long            nr_lvls;
+    long            nr_lvl_build_attempts;
+    double          seconds;
+    double          seconds_lvl_build;
+    double          seconds_player;         //Player (bot) turns, except building levels
+    double          seconds_mon;            //Monster turns
+    vector<long>    nr_turns_on_dlvl;       //Indexed by dungeon level
+};
+
+//The worker running in this thread (for reporting crashes)
+thread_local Worker_result                      cur_result_;
+thread_local chrono::steady_clock::time_point   cur_start_time_;
+
+double seconds_since(const chrono::steady_clock::time_point& t)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - t).count();
+}
+
+void print_result(const Worker_result& result, ostream& out)
+{
+    const double SECONDS_DIV = max(result.seconds, 0.001);
+
+    out << "Dormant monster distance: " << result.mon_dormant_dist          << endl
+        << "Runs finished:            " << result.nr_runs_finished          << endl
+        << "Player deaths:            " << result.nr_deaths                 << endl
+        << "Seconds:                  " << result.seconds                   << endl
+        << "Turns:                    " << result.nr_turns                  << endl
+        << "Turns per second:         " << result.nr_turns / SECONDS_DIV    << endl
+        << "Levels:                   " << result.nr_lvls                   << endl
+        << "Levels per second:        " << result.nr_lvls / SECONDS_DIV     << endl
+        << "Level build attempts:     " << result.nr_lvl_build_attempts     << endl
+        << "Seconds building levels:  " << result.seconds_lvl_build         << endl
+        << "Seconds in player turns:  " << result.seconds_player            << endl
+        << "Seconds in monster turns: " << result.seconds_mon               << endl;
+}
+
+//Reports where the worker was when an assert failed or the program crashed, then lets
+//the signal do its default thing (NOTE: This is not async signal safe, but it is only a
+//last attempt at reporting something useful before the process dies anyway)
+void on_crash(int sig)
+{
+    cerr << endl << "BOT CRASHED (signal " << sig << "), seed " << cur_result_.seed
+         << ", dungeon level " << map::dlvl << ", turn " << game_time::turn() << endl;
+
+    cur_result_.seconds = seconds_since(cur_start_time_);
+
+    print_result(cur_result_, cerr);
+
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+void set_crash_handler(void (*handler)(int))
+{
+    signal(SIGABRT, handler);
+    signal(SIGSEGV, handler);
+    signal(SIGFPE,  handler);
+}
+
+//Sets up what is shared by all workers in the process
+void init_headless(const Render_backend backend)
+{
+    TRACE_FUNC_BEGIN;
+
+    config::set_render_backend(backend);
+
+    init::init_iO();
+    init::init_game();
+
+    if (!config::is_bot_playing())
+    {
+        config::toggle_bot_playing();
+    }
+
+    set_crash_handler(on_crash);
+
+    TRACE_FUNC_END;
+}
+
+void cleanup_headless()
+{
+    TRACE_FUNC_BEGIN;
+
+    set_crash_handler(SIG_DFL);
+
+    init::cleanup_game();
+    init::cleanup_iO();
+
+    TRACE_FUNC_END;
+}
+
+//Draws the map and interface of the current session, and saves it as a PPM image
+void save_snapshot(const string& file_path)
+{
+    render::draw_map_and_interface(false);
+
+    if (!render::save_ppm(file_path))
+    {
+        cerr << "Failed to save snapshot " << file_path << endl;
+    }
+}
+
+//Plays the games of one worker in the calling thread (the game sessions are thread local).
+//If a snapshot path is given, the screen is saved there when the last game is finished.
+Worker_result play_games(const unsigned long SEED, const int NR_RUNS, const int MAX_DLVL,
+                         const int MON_DORMANT_DIST, const string& snapshot_path)
+{
+    TRACE_FUNC_BEGIN;
+
+    rnd::seed(SEED);
+
+    bot::set_max_dlvl(MAX_DLVL);
+
+    config::set_mon_dormant_dist(MON_DORMANT_DIST);
+
+    Worker_result& res = cur_result_;
+
+    res                     = Worker_result();
+    res.seed                = SEED;
+    res.mon_dormant_dist    = MON_DORMANT_DIST;
+    cur_start_time_ = chrono::steady_clock::now();
+
+    const long      NR_LVL_BUILD_ATTEMPTS_BEFORE    = map_travel::nr_lvl_build_attempts();
+    const double    LVL_BUILD_SECONDS_BEFORE        = map_travel::lvl_build_seconds();
+
+    while (res.nr_runs_finished + res.nr_deaths < NR_RUNS)
+    {
+        init::init_session();
+
+        const int NR_RUNS_FINISHED_BEFORE = res.nr_runs_finished;
+
+        player_bon::set_all_traits_to_picked();
+        create_character::create_character();
+        map::player->mk_start_items();
+        map_travel::go_to_nxt();
+        map::player->update_fov();
+
+        ++res.nr_lvls;
+
+        while (res.nr_runs_finished + res.nr_deaths < NR_RUNS)
+        {
+            if (!map::player->is_alive())
+            {
+                ++res.nr_deaths;
+                break;
+            }
+
+            const bool      IS_PLAYER               = game_time::cur_actor() == map::player;
+            const int       DLVL_BEFORE             = map::dlvl;
+            const int       TURN_BEFORE             = game_time::turn();
+            const double    LVL_BUILD_SECONDS_PREV  = map_travel::lvl_build_seconds();
+            const auto      turn_start_time         = chrono::steady_clock::now();
+
+            game_time::run_cur_actor_turn();
+
+            const double SECONDS = seconds_since(turn_start_time);
+
+            if (IS_PLAYER)
+            {
+                //Levels are built when the player descends
+                res.seconds_player +=
+                    SECONDS - (map_travel::lvl_build_seconds() - LVL_BUILD_SECONDS_PREV);
+            }
+            else //Monster
+            {
+                res.seconds_mon += SECONDS;
+            }
+
+            const int NR_TURNS = game_time::turn() - TURN_BEFORE;
+
+            assert(DLVL_BEFORE < int(res.nr_turns_on_dlvl.size()));
+
+            res.nr_turns                        += NR_TURNS;
+            res.nr_turns_on_dlvl[DLVL_BEFORE]   += NR_TURNS;
+
+            //NOTE: The bot goes back to the first level when a run is finished
+            if (map::dlvl > DLVL_BEFORE)
+            {
+                res.nr_lvls += map::dlvl - DLVL_BEFORE;
+            }
+
+            res.nr_runs_finished = NR_RUNS_FINISHED_BEFORE + bot::nr_runs_finished();
+        }
+
+        if (!snapshot_path.empty() && res.nr_runs_finished + res.nr_deaths >= NR_RUNS)
+        {
+            save_snapshot(snapshot_path);
+        }
+
+        init::cleanup_session();
+    }
+
+    res.nr_lvl_build_attempts   = map_travel::nr_lvl_build_attempts() -
+                                  NR_LVL_BUILD_ATTEMPTS_BEFORE;
+    res.seconds_lvl_build       = map_travel::lvl_build_seconds() - LVL_BUILD_SECONDS_BEFORE;
+    res.seconds                 = seconds_since(cur_start_time_);
+    res.is_ok                   = true;
+
+    TRACE_FUNC_END;
+
+    return res;
+}
+
+//The dormant distance from the options, or the game's default (set up by init_headless)
+int mon_dormant_dist(const Opts& opts)
+{
+    return opts.mon_dormant_dist >= 0 ? opts.mon_dormant_dist : config::mon_dormant_dist();
+}
+
+Worker_result run_worker(const Opts& opts, const unsigned long SEED, const int NR_RUNS)
+{
+    const bool IS_SNAPSHOT = !opts.snapshot_prefix.empty();
+
+    init_headless(IS_SNAPSHOT ? Render_backend::mem : Render_backend::none);
+
+    const string snapshot_path = IS_SNAPSHOT ?
+                                 (opts.snapshot_prefix + to_str(SEED) + ".ppm") : "";
+
+    const Worker_result res = play_games(SEED, NR_RUNS, opts.max_dlvl, mon_dormant_dist(opts),
+                                         snapshot_path);
+
+    cleanup_headless();
+
+    return res;
+}
+
+struct Worker_job
+{
+    unsigned long   seed;
+    int             nr_runs;
+};
+
+//The runs are split evenly over the workers, worker number N uses seed + N
+vector<Worker_job> mk_worker_jobs(const Opts& opts, const int NR_WORKERS)
+{
+    vector<Worker_job> jobs;
+
+    for (int i = 0; i < NR_WORKERS; ++i)
+    {
+        const int NR_RUNS = (opts.nr_runs / NR_WORKERS) + (i < opts.nr_runs % NR_WORKERS);
+
+        if (NR_RUNS > 0)
+        {
+            jobs.push_back({opts.seed + i, NR_RUNS});
+        }
+    }
+
+    return jobs;
+}
+
+struct Thread_pool
+{
+    vector<Worker_job>      jobs;
+    vector<Worker_result>   results;    //Indexed like the jobs
+    SDL_atomic_t            nxt_job_idx;
+    int                     max_dlvl;
+    int                     mon_dormant_dist;
+};
+
+int run_pool_thread(void* data)
+{
+    Thread_pool& pool = *static_cast<Thread_pool*>(data);
+
+    while (true)
+    {
+        const int JOB_IDX = SDL_AtomicAdd(&pool.nxt_job_idx, 1);
+
+        if (JOB_IDX >= int(pool.jobs.size()))
+        {
+            break;
+        }
+
+        const Worker_job& job = pool.jobs[JOB_IDX];
+
+        pool.results[JOB_IDX] =
+            play_games(job.seed, job.nr_runs, pool.max_dlvl, pool.mon_dormant_dist, "");
+    }
+
+    return 0;
+}
+
+//NOTE: Unlike with worker processes, a crash in one worker takes down all workers (the
+//crash is still reported with the seed of the worker that crashed)
+//NOTE: Nothing is drawn here, since the screen is shared by all threads
+void run_workers_in_threads(const Opts& opts, const int NR_THREADS,
+                            vector<Worker_result>& results)
+{
+    init_headless(Render_backend::none);
+
+    Thread_pool pool;
+
+    pool.jobs               = mk_worker_jobs(opts, opts.nr_workers);
+    pool.max_dlvl           = opts.max_dlvl;
+    pool.mon_dormant_dist   = mon_dormant_dist(opts);
+
+    pool.results.resize(pool.jobs.size());
+
+    SDL_AtomicSet(&pool.nxt_job_idx, 0);
+
+    vector<SDL_Thread*> threads;
+
+    const int NR_THREADS_USED = min(NR_THREADS, int(pool.jobs.size()));
+
+    for (int i = 0; i < NR_THREADS_USED; ++i)
+    {
+        SDL_Thread* const thread = SDL_CreateThread(run_pool_thread, "bot_worker", &pool);
+
+        if (!thread)
+        {
+            cerr << "Failed to start worker thread: " << SDL_GetError() << endl;
+            break;
+        }
+
+        threads.push_back(thread);
+    }
+
+    if (threads.empty())
+    {
+        //Play all games in this thread instead
+        run_pool_thread(&pool);
+    }
+
+    for (SDL_Thread* const thread : threads)
+    {
+        SDL_WaitThread(thread, nullptr);
+    }
+
+    cleanup_headless();
+
+    results.insert(end(results), begin(pool.results), end(pool.results));
+}
+
+#ifndef _WIN32
+//The results are sent from the worker processes to the farm as one line of text
+void write_result(const Worker_result& result, ostream& out)
+{
+    out.precision(10);
+
+    out << result.seed                  << " "
+        << result.is_ok                 << " "
+        << result.mon_dormant_dist      << " "
+        << result.nr_runs_finished      << " "
+        << result.nr_deaths             << " "
+        << result.nr_turns              << " "
+        << result.nr_lvls               << " "
+        << result.nr_lvl_build_attempts << " "
+        << result.seconds               << " "
+        << result.seconds_lvl_build     << " "
+        << result.seconds_player        << " "
+        << result.seconds_mon           << " "
+        << result.nr_turns_on_dlvl.size();
+
+    for (const long nr_turns : result.nr_turns_on_dlvl)
+    {
+        out << " " << nr_turns;
+    }
+
+    out << endl;
+}
+
+bool read_result(istream& in, Worker_result& result)
+{
+    size_t nr_dlvls = 0;
+
+    in >> result.seed
+       >> result.is_ok
+       >> result.mon_dormant_dist
+       >> result.nr_runs_finished
+       >> result.nr_deaths
+       >> result.nr_turns
+       >> result.nr_lvls
+       >> result.nr_lvl_build_attempts
+       >> result.seconds
+       >> result.seconds_lvl_build
+       >> result.seconds_player
+       >> result.seconds_mon
+       >> nr_dlvls;
+
+    if (in.fail() || nr_dlvls != result.nr_turns_on_dlvl.size())
+    {
+        return false;
+    }
+
+    for (long& nr_turns : result.nr_turns_on_dlvl)
+    {
+        in >> nr_turns;
+    }
+
+    return !in.fail();
+}
+
+void run_workers_in_processes(const Opts& opts, const int NR_WORKERS,
+                              vector<Worker_result>& results)
+{
+    struct Worker_process
+    {
+        pid_t           pid;
+        int             fd;
+        unsigned long   seed;
+    };
+
+    vector<Worker_process> workers;
+
+    //Do not let the workers inherit anything buffered
+    cout.flush();
+    cerr.flush();
+
+    for (const Worker_job& job : mk_worker_jobs(opts, NR_WORKERS))
+    {
+        const unsigned long SEED    = job.seed;
+        const int           NR_RUNS = job.nr_runs;
+
+        int fds[2];
+
+        if (pipe(fds) != 0)
+        {
+            cerr << "Failed to create pipe for worker" << endl;
+            break;
+        }
+
+        const pid_t pid = fork();
+
+        if (pid == 0)
+        {
+            //This is the worker process
+            close(fds[0]);
+
+            const Worker_result result = run_worker(opts, SEED, NR_RUNS);
+
+            ostringstream result_stream;
+            write_result(result, result_stream);
+
+            const string    result_str  = result_stream.str();
+            const ssize_t   NR_WRITTEN  = write(fds[1], result_str.data(), result_str.size());
+
+            close(fds[1]);
+
+            _exit(NR_WRITTEN == ssize_t(result_str.size()) ? 0 : 1);
+        }
+
+        close(fds[1]);
+
+        if (pid < 0)
+        {
+            cerr << "Failed to start worker process" << endl;
+            close(fds[0]);
+            break;
+        }
+
+        workers.push_back({pid, fds[0], SEED});
+    }
+
+    for (const Worker_process& worker : workers)
+    {
+        string  result_str;
+        char    buffer[1024];
+        ssize_t nr_read = 0;
+
+        while ((nr_read = read(worker.fd, buffer, sizeof(buffer))) > 0)
+        {
+            result_str.append(buffer, nr_read);
+        }
+
+        close(worker.fd);
+
+        int status = 0;
+        waitpid(worker.pid, &status, 0);
+
+        Worker_result result;
+        istringstream result_stream(result_str);
+
+        const bool IS_OK = WIFEXITED(status) && WEXITSTATUS(status) == 0 &&
+                           read_result(result_stream, result);
+
+        if (!IS_OK)
+        {
+            result          = Worker_result();
+            result.seed     = worker.seed;
+            result.is_ok    = false;
+
+            cerr << "Worker with seed " << worker.seed << " failed (";
+
+            if (WIFSIGNALED(status))
+            {
+                cerr << "signal " << WTERMSIG(status);
+            }
+            else
+            {
+                cerr << "exit status " << WEXITSTATUS(status);
+            }
+
+            cerr << ")" << endl;
+        }
+
+        results.push_back(result);
+    }
+}
+#endif // _WIN32
+
+Worker_result merged(const vector<Worker_result>& results, const double SECONDS)
+{
+    Worker_result total;
+
+    total.is_ok     = true;
+    total.seconds   = SECONDS;
+
+    for (const Worker_result& result : results)
+    {
+        total.is_ok                  = total.is_ok && result.is_ok;
+
+        //All workers use the same dormant distance (failed workers did not report it)
+        if (result.is_ok)
+        {
+            total.mon_dormant_dist = result.mon_dormant_dist;
+        }
+
+        total.nr_runs_finished      += result.nr_runs_finished;
+        total.nr_deaths             += result.nr_deaths;
+        total.nr_turns              += result.nr_turns;
+        total.nr_lvls               += result.nr_lvls;
+        total.nr_lvl_build_attempts += result.nr_lvl_build_attempts;
+        total.seconds_lvl_build     += result.seconds_lvl_build;
+        total.seconds_player        += result.seconds_player;
+        total.seconds_mon           += result.seconds_mon;
+
+        for (size_t dlvl = 0; dlvl < total.nr_turns_on_dlvl.size(); ++dlvl)
+        {
+            total.nr_turns_on_dlvl[dlvl] += result.nr_turns_on_dlvl[dlvl];
+        }
+    }
+
+    return total;
+}
+
+void write_csv_row(ostream& out, const string& label, const Worker_result& result,
+                   const int MAX_DLVL)
+{
+    const double SECONDS_DIV = max(result.seconds, 0.001);
+
+    out << label                                << ","
+        << (result.is_ok ? "ok" : "failed")     << ","
+        << result.mon_dormant_dist              << ","
+        << result.nr_runs_finished              << ","
+        << result.nr_deaths                     << ","
+        << result.seconds                       << ","
+        << result.nr_turns                      << ","
+        << result.nr_turns / SECONDS_DIV        << ","
+        << result.nr_lvls                       << ","
+        << result.nr_lvls / SECONDS_DIV         << ","
+        << result.nr_lvl_build_attempts         << ","
+        << result.seconds_lvl_build             << ","
+        << result.seconds_player                << ","
+        << result.seconds_mon;
+
+    for (int dlvl = 1; dlvl <= MAX_DLVL; ++dlvl)
+    {
+        out << "," << result.nr_turns_on_dlvl[dlvl];
+    }
+
+    out << endl;
+}
+
+void write_csv(ostream& out, const vector<Worker_result>& results,
+               const Worker_result& total, const int MAX_DLVL)
+{
+    out << "seed,status,mon_dormant_dist,runs_finished,deaths,seconds,turns,"
+        << "turns_per_second,levels,levels_per_second,lvl_build_attempts,seconds_lvl_build,"
+        << "seconds_player,seconds_mon";
+
+    for (int dlvl = 1; dlvl <= MAX_DLVL; ++dlvl)
+    {
+        out << ",turns_dlvl_" << dlvl;
+    }
+
+    out << endl;
+
+    for (const Worker_result& result : results)
+    {
+        write_csv_row(out, to_str(result.seed), result, MAX_DLVL);
+    }
+
+    write_csv_row(out, "total", total, MAX_DLVL);
+}
+
+void write_json_obj(ostream& out, const Worker_result& result, const bool IS_TOTAL,
+                    const int MAX_DLVL)
+{
+    const double SECONDS_DIV = max(result.seconds, 0.001);
+
+    out << "{";
+
+    if (!IS_TOTAL)
+    {
+        out << "\"seed\": " << result.seed << ", ";
+    }
+
+    out << "\"ok\": "                   << (result.is_ok ? "true" : "false")    << ", "
+        << "\"mon_dormant_dist\": "     << result.mon_dormant_dist              << ", "
+        << "\"runs_finished\": "        << result.nr_runs_finished              << ", "
+        << "\"deaths\": "               << result.nr_deaths                     << ", "
+        << "\"seconds\": "              << result.seconds                       << ", "
+        << "\"turns\": "                << result.nr_turns                      << ", "
+        << "\"turns_per_second\": "     << result.nr_turns / SECONDS_DIV        << ", "
+        << "\"levels\": "               << result.nr_lvls                       << ", "
+        << "\"levels_per_second\": "    << result.nr_lvls / SECONDS_DIV         << ", "
+        << "\"lvl_build_attempts\": "   << result.nr_lvl_build_attempts         << ", "
+        << "\"seconds_lvl_build\": "    << result.seconds_lvl_build             << ", "
+        << "\"seconds_player\": "       << result.seconds_player                << ", "
+        << "\"seconds_mon\": "          << result.seconds_mon                   << ", "
+        << "\"turns_per_dlvl\": [";
+
+    for (int dlvl = 1; dlvl <= MAX_DLVL; ++dlvl)
+    {
+        out << (dlvl > 1 ? ", " : "") << result.nr_turns_on_dlvl[dlvl];
+    }
+
+    out << "]}";
+}
+
+void write_json(ostream& out, const vector<Worker_result>& results,
+                const Worker_result& total, const int MAX_DLVL)
+{
+    out << "{" << endl
+        << "  \"max_dlvl\": " << MAX_DLVL << "," << endl
+        << "  \"workers\": [" << endl;
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        out << "    ";
+        write_json_obj(out, results[i], false, MAX_DLVL);
+        out << (i + 1 < results.size() ? "," : "") << endl;
+    }
+
+    out << "  ]," << endl
+        << "  \"total\": ";
+
+    write_json_obj(out, total, true, MAX_DLVL);
+
+    out << endl << "}" << endl;
+}
+
+bool is_json_path(const string& path)
+{
+    const string ext = ".json";
+
+    return path.size() >= ext.size() &&
+           path.compare(path.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+} //namespace
+
+int run(const Opts& opts)
+{
+    TRACE_FUNC_BEGIN;
+
+    assert(opts.nr_runs >= 1);
+    assert(opts.nr_workers >= 1);
+    assert(opts.max_dlvl >= 1 && opts.max_dlvl <= DLVL_LAST);
+
+    assert(opts.nr_threads >= 0);
+
+    int nr_threads = opts.nr_threads;
+
+#ifdef _WIN32
+    if (opts.nr_workers > 1 && nr_threads == 0)
+    {
+        cout << "Worker processes are not supported on this platform, "
+             << "running the workers on threads instead" << endl;
+        nr_threads = opts.nr_workers;
+    }
+#endif // _WIN32
+
+    if (nr_threads > 0 && !opts.snapshot_prefix.empty())
+    {
+        cout << "Snapshots are not supported when running the workers on threads, "
+             << "no snapshots will be saved" << endl;
+    }
+
+    vector<Worker_result> results;
+
+    const auto start_time = chrono::steady_clock::now();
+
+    if (nr_threads > 0)
+    {
+        run_workers_in_threads(opts, nr_threads, results);
+    }
+    else if (opts.nr_workers == 1)
+    {
+        results.push_back(run_worker(opts, opts.seed, opts.nr_runs));
+    }
+    else //Several worker processes
+    {
+#ifndef _WIN32
+        run_workers_in_processes(opts, opts.nr_workers, results);
+#endif // _WIN32
+    }
+
+    const Worker_result total = merged(results, seconds_since(start_time));
+
+    cout << "Seed:                     " << opts.seed       << endl
+         << "Max dungeon level:        " << opts.max_dlvl   << endl
+         << "Workers:                  " << results.size()  << endl
+         << "Failed workers:           ";
+
+    int nr_failed_workers = 0;
+
+    for (const Worker_result& result : results)
+    {
+        if (!result.is_ok)
+        {
+            cout << (nr_failed_workers == 0 ? "" : ", ") << "seed " << result.seed;
+            ++nr_failed_workers;
+        }
+    }
+
+    cout << (nr_failed_workers == 0 ? "none" : "") << endl;
+
+    print_result(total, cout);
+
+    if (!opts.report_path.empty())
+    {
+        ofstream file(opts.report_path.c_str(), ios::trunc);
+
+        if (file.is_open())
+        {
+            if (is_json_path(opts.report_path))
+            {
+                write_json(file, results, total, opts.max_dlvl);
+            }
+            else //CSV
+            {
+                write_csv(file, results, total, opts.max_dlvl);
+            }
+        }
+        else //Failed to open file
+        {
+            cerr << "Failed to open report file " << opts.report_path << endl;
+        }
+    }
+
+    TRACE_FUNC_END;
+
+    return total.is_ok ? 0 : 1;
+}
+
+} //bot_farm
@@ -24,9 +24,12 @@ namespace config
 namespace
 {
 
-const int NR_OPTIONS  = 13;
+const int NR_OPTIONS  = 14;
 const int OPT_Y0      = 1;
 
+//Monsters cannot see anything beyond the max field of view radius
+const int MON_DORMANT_DIST_DEFAULT = FOV_MAX_RADI_INT;
+
 string  font_name_                      = "";
 bool    is_fullscr_                     = false;
 bool    is_tiles_wall_full_square_      = false;
@@ -49,6 +52,11 @@ bool    is_audio_enabled_               = false;
 bool    is_tiles_mode_                  = false;
 int     cell_px_w_                      = -1;
 int     cell_px_h_                      = -1;
+Fov_algo fov_algo_                      = Fov_algo::ray;
+Render_backend render_backend_          = Render_backend::sdl;
+
+//The bot changes this between its runs, so each thread (i.e. each bot game) has its own
+thread_local int mon_dormant_dist_ = -1;
 
 vector<string> font_image_names;
 
@@ -121,6 +129,7 @@ void set_default_variables()
     delay_projectile_draw_          = 50;
     delay_shotgun_                  = 120;
     delay_explosion_                = 300;
+    fov_algo_                       = Fov_algo::ray;
     TRACE_FUNC_END;
 }
 
@@ -240,6 +249,11 @@ void player_sets_option(const Menu_browser* const browser, const int OPTION_VALU
     } break;
 
     case 12:
+        fov_algo_ = fov_algo_ == Fov_algo::shadow_cast ?
+                    Fov_algo::ray : Fov_algo::shadow_cast;
+        break;
+
+    case 13:
         set_default_variables();
         set_cell_px_dims_from_font_name();
         set_cell_px_dim_dependent_variables();
@@ -420,6 +434,19 @@ void draw(const Menu_browser* const browser, const int OPTION_VALUES_X_POS)
                       clr_menu_highlight : clr_menu_drk);
     opt_nr++;
 
+    str = "Field of view algorithm";
+    render::draw_text(str, Panel::screen, Pos(X0, OPT_Y0 + opt_nr),
+                      browser->pos().y == opt_nr ?
+                      clr_menu_highlight : clr_menu_drk);
+    render::draw_text(":", Panel::screen, Pos(X1 - 2, OPT_Y0 + opt_nr),
+                      browser->pos().y == opt_nr ?
+                      clr_menu_highlight : clr_menu_drk);
+    str = fov_algo_ == Fov_algo::shadow_cast ? "Shadow casting" : "Ray casting";
+    render::draw_text(str, Panel::screen, Pos(X1, OPT_Y0 + opt_nr),
+                      browser->pos().y == opt_nr ?
+                      clr_menu_highlight : clr_menu_drk);
+    opt_nr++;
+
     str = "Reset to defaults";
     render::draw_text(str, Panel::screen, Pos(X0, OPT_Y0 + opt_nr + 1),
                       browser->pos().y == opt_nr ?
@@ -524,6 +551,14 @@ void set_all_variables_from_lines(vector<string>& lines)
     delay_explosion_ = to_int(cur_line);
     lines.erase(begin(lines));
 
+    //NOTE: Config files written before this option existed lack this line
+    if (!lines.empty())
+    {
+        cur_line = lines.front();
+        fov_algo_ = cur_line == "0" ? Fov_algo::ray : Fov_algo::shadow_cast;
+        lines.erase(begin(lines));
+    }
+
     TRACE_FUNC_END;
 }
 
@@ -558,6 +593,7 @@ void collect_lines_from_variables(vector<string>& lines)
     lines.push_back(to_str(delay_projectile_draw_));
     lines.push_back(to_str(delay_shotgun_));
     lines.push_back(to_str(delay_explosion_));
+    lines.push_back(fov_algo_ == Fov_algo::ray ? "0" : "1");
     TRACE_FUNC_END;
 }
 
@@ -565,8 +601,9 @@ void collect_lines_from_variables(vector<string>& lines)
 
 void init()
 {
-    font_name_     = "";
-    is_bot_playing_ = false;
+    font_name_          = "";
+    is_bot_playing_     = false;
+    mon_dormant_dist_   = MON_DORMANT_DIST_DEFAULT;
 
     font_image_names.clear();
     font_image_names.push_back("images/8x12_DOS.png");
@@ -613,12 +650,21 @@ bool    is_tiles_wall_full_square()     {return is_tiles_wall_full_square_;}
 bool    is_audio_enabled()              {return is_audio_enabled_;}
 bool    is_bot_playing()                {return is_bot_playing_;}
 void    toggle_bot_playing()            {is_bot_playing_ = !is_bot_playing_;}
+int     mon_dormant_dist()              {return mon_dormant_dist_;}
+void    set_mon_dormant_dist(const int DIST) {mon_dormant_dist_ = DIST;}
 bool    is_ranged_wpn_meleee_prompt()   {return is_ranged_wpn_meleee_prompt_;}
 bool    is_ranged_wpn_auto_reload()     {return is_ranged_wpn_auto_reload_;}
 bool    is_intro_lvl_skipped()          {return is_intro_lvl_skipped_;}
 int     delay_projectile_draw()         {return delay_projectile_draw_;}
 int     delay_shotgun()                 {return delay_shotgun_;}
 int     delay_explosion()               {return delay_explosion_;}
+Fov_algo fov_algo()                     {return fov_algo_;}
+Render_backend render_backend()         {return render_backend_;}
+
+void set_render_backend(const Render_backend backend)
+{
+    render_backend_ = backend;
+}
 
 void run_options_menu()
 {
@@ -23,10 +23,10 @@ namespace dungeon_master
 namespace
 {
 
-int       xp_for_lvl_[PLAYER_MAX_CLVL + 1];
-int       clvl_  = 0;
-int       xp_    = 0;
-Time_data  time_started_;
+thread_local int       xp_for_lvl_[PLAYER_MAX_CLVL + 1];
+thread_local int       clvl_  = 0;
+thread_local int       xp_    = 0;
+thread_local Time_data  time_started_;
 
 void player_gain_lvl()
 {
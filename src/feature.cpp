@@ -43,9 +43,9 @@ void Feature::bump(Actor& actor_bumping)
     }
 }
 
-void Feature::add_light(bool light[MAP_W][MAP_H]) const
+Lgt_size Feature::lgt_size() const
 {
-    (void)light;
+    return Lgt_size::none;
 }
 
 bool Feature::can_move_cmn() const {return data().move_rules.can_move_cmn();}
@@ -88,7 +88,7 @@ bool Move_rules::can_move(const bool actor_prop_ids[size_t(Prop_id::END)]) const
 namespace feature_data
 {
 
-Feature_data_t data_list[int(Feature_id::END)];
+thread_local Feature_data_t data_list[int(Feature_id::END)];
 
 namespace
 {
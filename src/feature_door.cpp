@@ -673,7 +673,7 @@ void Door::try_close(Actor* actor_trying)
 
         if (!TRYER_IS_BLIND)
         {
-            is_open_ = false;
+            set_open(false);
 
             if (IS_PLAYER)
             {
@@ -699,7 +699,7 @@ void Door::try_close(Actor* actor_trying)
         {
             if (rnd::percent() < 50)
             {
-                is_open_ = false;
+                set_open(false);
 
                 if (IS_PLAYER)
                 {
@@ -785,7 +785,7 @@ void Door::try_open(Actor* actor_trying)
         if (!TRYER_IS_BLIND)
         {
             TRACE << "Tryer can see, opening" << endl;
-            is_open_ = true;
+            set_open(true);
 
             if (IS_PLAYER)
             {
@@ -816,7 +816,7 @@ void Door::try_open(Actor* actor_trying)
             if (rnd::percent() < 50)
             {
                 TRACE << "Tryer is blind, but open succeeded anyway" << endl;
-                is_open_ = true;
+                set_open(true);
 
                 if (IS_PLAYER)
                 {
@@ -894,8 +894,22 @@ Did_open Door::open(Actor* const actor_opening)
 {
     (void)actor_opening;
 
-    is_open_   = true;
+    set_open(true);
     is_secret_ = false;
     is_stuck_  = false;
     return Did_open::yes;
 }
+
+void Door::set_to_secret()
+{
+    set_open(false);
+    is_secret_ = false;
+}
+
+void Door::set_open(const bool IS_OPEN)
+{
+    is_open_ = IS_OPEN;
+
+    //Doors block or allow LOS, movement and projectiles depending on if they are open
+    map::update_obstr_layers(pos_);
+}
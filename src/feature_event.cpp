@@ -127,7 +127,7 @@ void Event_wall_crumble::on_new_turn()
 
             int nr_mon_spawned = 0;
 
-            random_shuffle(begin(inner_cells_), end(inner_cells_));
+            rnd::shuffle(begin(inner_cells_), end(inner_cells_));
 
             for (const Pos& p : inner_cells_)
             {
@@ -11,6 +11,7 @@
 #include "map.hpp"
 #include "feature_rigid.hpp"
 #include "fov.hpp"
+#include "map_bits.hpp"
 #include "inventory.hpp"
 #include "item.hpp"
 #include "msg_log.hpp"
@@ -72,10 +73,7 @@ void Smoke::on_new_turn()
         //Choking (this is determined by rBreath)?
         if (rnd::one_in(4))
         {
-            bool props[size_t(Prop_id::END)];
-            actor->prop_handler().prop_ids(props);
-
-            if (!props[int(Prop_id::rBreath)])
+            if (!actor->prop_handler().has_prop(Prop_id::rBreath))
             {
                 string snd_msg = "";
 
@@ -158,32 +156,9 @@ void Lit_flare::on_new_turn()
     if (nr_turns_left_ <= 0) {game_time::erase_mob(this, true);}
 }
 
-void Lit_flare::add_light(bool light[MAP_W][MAP_H]) const
+Lgt_size Lit_flare::lgt_size() const
 {
-    bool my_light[MAP_W][MAP_H];
-    utils::reset_array(my_light, false);
-    const int R = FOV_STD_RADI_INT; //light_radius();
-    Pos p0(max(0,         pos_.x - R),  max(0,          pos_.y - R));
-    Pos p1(min(MAP_W - 1, pos_.x + R),  min(MAP_H - 1,  pos_.y + R));
-    bool blocked_los[MAP_W][MAP_H];
-
-    for (int y = p0.y; y <= p1.y; ++y)
-    {
-        for (int x = p0.x; x <= p1.x; ++x)
-        {
-            blocked_los[x][y] = !map::cells[x][y].rigid->is_los_passable();
-        }
-    }
-
-    fov::run_fov_on_array(blocked_los, pos_, my_light, false);
-
-    for (int y = p0.y; y <= p1.y; ++y)
-    {
-        for (int x = p0.x; x <= p1.x; ++x)
-        {
-            if (my_light[x][y]) {light[x][y] = true;}
-        }
-    }
+    return Lgt_size::fov;
 }
 
 string Lit_flare::name(const Article article)  const
@@ -9,6 +9,7 @@
 #include "utils.hpp"
 #include "popup.hpp"
 #include "map_travel.hpp"
+#include "map_gen.hpp"
 #include "save_handling.hpp"
 #include "item_factory.hpp"
 #include "map_parsing.hpp"
@@ -169,6 +170,8 @@ void Rigid::try_start_burning(const bool IS_MSG_ALLOWED)
         }
 
         burn_state_ = Burn_state::burning;
+
+        map::activate_rigid(pos_);
     }
 }
 
@@ -963,7 +966,7 @@ void Stairs::bump(Actor& actor_bumping)
         switch (CHOICE)
         {
         case 0:
-            map::player->pos = pos_;
+            map::player->set_pos(pos_);
             msg_log::clear();
             msg_log::add("I descend the stairs.");
             render::draw_map_and_interface();
@@ -971,7 +974,7 @@ void Stairs::bump(Actor& actor_bumping)
             break;
 
         case 1:
-            map::player->pos = pos_;
+            map::player->set_pos(pos_);
             save_handling::save();
             init::quit_to_main_menu = true;
             break;
@@ -1660,6 +1663,14 @@ Tomb::Tomb(const Pos& feature_pos) :
     appearance_(Tomb_appearance::common),
     is_random_appearance_(false),
     trait_(Tomb_trait::END)
+{
+    if (!map_gen::is_mk_items_deferred)
+    {
+        mk_items();
+    }
+}
+
+void Tomb::mk_items()
 {
     //Contained items
     const int NR_ITEMS_MIN  = rnd::one_in(3) ? 0 : 1;
@@ -2052,6 +2063,14 @@ Chest::Chest(const Pos& feature_pos) :
     is_trap_status_known_(false),
     matl_(Chest_matl(rnd::range(0, int(Chest_matl::END) - 1))),
     TRAP_DET_LVL(rnd::range(0, 2))
+{
+    if (!map_gen::is_mk_items_deferred)
+    {
+        mk_items();
+    }
+}
+
+void Chest::mk_items()
 {
     const bool  IS_TREASURE_HUNTER  = player_bon::traits[int(Trait::treasure_hunter)];
     const int   NR_ITEMS_MIN        = rnd::one_in(10)      ? 0 : 1;
@@ -2571,7 +2590,7 @@ Fountain::Fountain(const Pos& feature_pos) :
             Fountain_effect::rConf
         };
 
-        std::random_shuffle(begin(effect_bucket), end(effect_bucket));
+        rnd::shuffle(begin(effect_bucket), end(effect_bucket));
 
         const int NR_EFFECTS = 3;
 
@@ -2779,6 +2798,14 @@ void Fountain::bump(Actor& actor_bumping)
 Cabinet::Cabinet(const Pos& feature_pos) :
     Rigid(feature_pos),
     is_open_(false)
+{
+    if (!map_gen::is_mk_items_deferred)
+    {
+        mk_items();
+    }
+}
+
+void Cabinet::mk_items()
 {
     const int IS_EMPTY_N_IN_10  = 5;
     const int NR_ITEMS_MIN      = rnd::fraction(IS_EMPTY_N_IN_10, 10) ? 0 : 1;
@@ -2888,6 +2915,14 @@ Cocoon::Cocoon(const Pos& feature_pos) :
     Rigid(feature_pos),
     is_trapped_(rnd::fraction(6, 10)),
     is_open_(false)
+{
+    if (!map_gen::is_mk_items_deferred)
+    {
+        mk_items();
+    }
+}
+
+void Cocoon::mk_items()
 {
     if (is_trapped_)
     {
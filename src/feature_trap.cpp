@@ -274,7 +274,7 @@ void Trap::disarm()
         {
             if (trap_type() == Trap_id::web)
             {
-                map::player->pos = pos_;
+                map::player->set_pos(pos_);
             }
 
             trigger_trap(map::player);
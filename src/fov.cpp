@@ -6,8 +6,11 @@
 #include <vector>
 
 #include "cmn_types.hpp"
+#include "config.hpp"
 #include "line_calc.hpp"
 #include "map.hpp"
+#include "map_bits.hpp"
+#include "feature_rigid.hpp"
 #include "utils.hpp"
 
 using namespace std;
@@ -79,6 +82,210 @@ void check_one_cell_of_many(const bool obstructions[MAP_W][MAP_H],
     }
 }
 
+void run_ray_fov(const bool obstructions[MAP_W][MAP_H], const Pos& origin,
+                 bool values[MAP_W][MAP_H], const bool IS_AFFECTED_BY_DARKNESS)
+{
+    const int check_x_end = min(MAP_W - 1, origin.x + FOV_STD_RADI_INT);
+    const int check_y_end = min(MAP_H - 1, origin.y + FOV_STD_RADI_INT);
+
+    int check_x = max(0, origin.x - FOV_STD_RADI_INT);
+
+    while (check_x <= check_x_end)
+    {
+        int check_y = max(0, origin.y - FOV_STD_RADI_INT);
+
+        while (check_y <= check_y_end)
+        {
+            check_one_cell_of_many(obstructions, Pos(check_x, check_y), origin, values,
+                                   IS_AFFECTED_BY_DARKNESS);
+            check_y++;
+        }
+
+        check_x++;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Shadow casting
+//-----------------------------------------------------------------------------
+//Octant transforms, from (column, row) in the octant to map deltas
+const int octant_mult[4][8] =
+{
+    {1,  0,  0, -1, -1,  0,  0,  1},
+    {0,  1, -1,  0,  0, -1,  1,  0},
+    {0,  1,  1,  0,  0, -1, -1,  0},
+    {1,  0,  0,  1, -1,  0,  0, -1}
+};
+
+struct Shadow_cast_data
+{
+    Shadow_cast_data(const bool obstructions_[MAP_W][MAP_H], const Pos& origin_,
+                     bool values_[MAP_W][MAP_H], const bool IS_AFFECTED_BY_DARKNESS_) :
+        obstructions            (obstructions_),
+        origin                  (origin_),
+        values                  (values_),
+        IS_AFFECTED_BY_DARKNESS (IS_AFFECTED_BY_DARKNESS_)
+    {
+        for (int x = 0; x < FOV_STD_W_INT; ++x)
+        {
+            for (int y = 0; y < FOV_STD_W_INT; ++y)
+            {
+                drk_path_state[x][y] = -1;
+            }
+        }
+    }
+
+    const bool (*obstructions)[MAP_H];
+    const Pos origin;
+    bool (*values)[MAP_H];
+    const bool IS_AFFECTED_BY_DARKNESS;
+
+    //Memoized result of is_drk_path_clear() per delta (-1 = not yet evaluated)
+    signed char drk_path_state[FOV_STD_W_INT][FOV_STD_W_INT];
+};
+
+//Applies the darkness rule of check_one_cell_of_many() incrementally: instead of
+//walking the whole precalculated line for each cell, each cell only checks the step
+//from the previous cell on its line, and reuses the (memoized) result of that cell.
+bool is_drk_path_clear(Shadow_cast_data& d, const Pos& delta)
+{
+    signed char& state =
+        d.drk_path_state[delta.x + FOV_STD_RADI_INT][delta.y + FOV_STD_RADI_INT];
+
+    if (state != -1)
+    {
+        return state == 1;
+    }
+
+    const vector<Pos>* path_deltas_ptr =
+        line_calc::fov_delta_line(delta, FOV_MAX_RADI_DB);
+
+    const size_t PATH_SIZE = path_deltas_ptr ? path_deltas_ptr->size() : 0;
+
+    bool is_clear = true;
+
+    //Cells adjacent to the origin are never blocked by darkness
+    if (PATH_SIZE > 2)
+    {
+        const Pos prev_delta((*path_deltas_ptr)[PATH_SIZE - 2]);
+
+        const Pos cur_pos (d.origin + delta);
+        const Pos prev_pos(d.origin + prev_delta);
+
+        const Cell& cur_cell  = map::cells[cur_pos.x][cur_pos.y];
+        const Cell& prev_cell = map::cells[prev_pos.x][prev_pos.y];
+
+        const bool IS_STEP_CLEAR =
+            cur_cell.is_lit || (!cur_cell.is_dark && !prev_cell.is_dark);
+
+        is_clear = IS_STEP_CLEAR && is_drk_path_clear(d, prev_delta);
+    }
+
+    state = is_clear ? 1 : 0;
+
+    return is_clear;
+}
+
+void cast_light(Shadow_cast_data& d, const int ROW, double start_slope,
+                const double END_SLOPE, const int XX, const int XY, const int YX,
+                const int YY)
+{
+    if (start_slope < END_SLOPE)
+    {
+        return;
+    }
+
+    const int R = FOV_STD_RADI_INT;
+
+    double new_start_slope = 0.0;
+
+    for (int dist = ROW; dist <= R; ++dist)
+    {
+        bool is_blocked = false;
+
+        const int DY = -dist;
+
+        for (int dx = -dist; dx <= 0; ++dx)
+        {
+            const double L_SLOPE = (dx - 0.5) / (DY + 0.5);
+            const double R_SLOPE = (dx + 0.5) / (DY - 0.5);
+
+            if (start_slope < R_SLOPE)
+            {
+                continue;
+            }
+            else if (END_SLOPE > L_SLOPE)
+            {
+                break;
+            }
+
+            const Pos delta(dx * XX + DY * XY, dx * YX + DY * YY);
+            const Pos p(d.origin + delta);
+
+            //Cells outside the map are treated as opaque
+            const bool IS_INSIDE_MAP = utils::is_pos_inside_map(p);
+
+            const bool IS_OPAQUE = !IS_INSIDE_MAP || d.obstructions[p.x][p.y];
+
+            const double C_SLOPE = double(dx) / DY;
+
+            const bool IS_CENTER_LIT = C_SLOPE <= start_slope && C_SLOPE >= END_SLOPE;
+
+            if (
+                IS_CENTER_LIT &&
+                IS_INSIDE_MAP &&
+                line_calc::fov_delta_line(delta, FOV_STD_RADI_DB))
+            {
+                if (
+                    !d.IS_AFFECTED_BY_DARKNESS      ||
+                    map::cells[p.x][p.y].is_lit     ||
+                    is_drk_path_clear(d, delta))
+                {
+                    d.values[p.x][p.y] = true;
+                }
+            }
+
+            if (is_blocked)
+            {
+                if (IS_OPAQUE)
+                {
+                    new_start_slope = R_SLOPE;
+                    continue;
+                }
+                else
+                {
+                    is_blocked  = false;
+                    start_slope = new_start_slope;
+                }
+            }
+            else if (IS_OPAQUE && dist < R)
+            {
+                is_blocked = true;
+                cast_light(d, dist + 1, start_slope, L_SLOPE, XX, XY, YX, YY);
+                new_start_slope = R_SLOPE;
+            }
+        }
+
+        if (is_blocked)
+        {
+            break;
+        }
+    }
+}
+
+void run_shadow_cast_fov(const bool obstructions[MAP_W][MAP_H], const Pos& origin,
+                         bool values[MAP_W][MAP_H], const bool IS_AFFECTED_BY_DARKNESS)
+{
+    Shadow_cast_data d(obstructions, origin, values, IS_AFFECTED_BY_DARKNESS);
+
+    for (int octant = 0; octant < 8; ++octant)
+    {
+        cast_light(d, 1, 1.0, 0.0,
+                   octant_mult[0][octant], octant_mult[1][octant],
+                   octant_mult[2][octant], octant_mult[3][octant]);
+    }
+}
+
 } //namespace
 
 bool check_cell(const bool obstructions[MAP_W][MAP_H], const Pos& cell_to_check,
@@ -138,59 +345,72 @@ bool check_cell(const bool obstructions[MAP_W][MAP_H], const Pos& cell_to_check,
 
 void run_fov_on_array(const bool obstructions[MAP_W][MAP_H], const Pos& origin,
                       bool values[MAP_W][MAP_H],
-                      const bool IS_AFFECTED_BY_DARKNESS)
+                      const bool IS_AFFECTED_BY_DARKNESS, const Fov_algo algo)
 {
     utils::reset_array(values, false);
 
     values[origin.x][origin.y] = true;
 
-    const int check_x_end = min(MAP_W - 1, origin.x + FOV_STD_RADI_INT);
-    const int check_y_end = min(MAP_H - 1, origin.y + FOV_STD_RADI_INT);
+    switch (algo)
+    {
+    case Fov_algo::ray:
+        run_ray_fov(obstructions, origin, values, IS_AFFECTED_BY_DARKNESS);
+        break;
 
-    int check_x = max(0, origin.x - FOV_STD_RADI_INT);
+    case Fov_algo::shadow_cast:
+        run_shadow_cast_fov(obstructions, origin, values, IS_AFFECTED_BY_DARKNESS);
+        break;
+    }
+}
 
-    while (check_x <= check_x_end)
-    {
-        int check_y = max(0, origin.y - FOV_STD_RADI_INT);
+void run_fov_on_array(const bool obstructions[MAP_W][MAP_H], const Pos& origin,
+                      bool values[MAP_W][MAP_H],
+                      const bool IS_AFFECTED_BY_DARKNESS)
+{
+    run_fov_on_array(obstructions, origin, values, IS_AFFECTED_BY_DARKNESS,
+                     config::fov_algo());
+}
 
-        while (check_y <= check_y_end)
+void add_fov_light(const Pos& origin, Map_bits& light)
+{
+    const int R = FOV_STD_RADI_INT;
+
+    const Rect fov_rect(Pos(max(0,         origin.x - R), max(0,         origin.y - R)),
+                        Pos(min(MAP_W - 1, origin.x + R), min(MAP_H - 1, origin.y + R)));
+
+    bool blocked_los[MAP_W][MAP_H];
+
+    for (int y = fov_rect.p0.y; y <= fov_rect.p1.y; ++y)
+    {
+        for (int x = fov_rect.p0.x; x <= fov_rect.p1.x; ++x)
         {
-            check_one_cell_of_many(obstructions, Pos(check_x, check_y), origin, values,
-                                   IS_AFFECTED_BY_DARKNESS);
-            check_y++;
+            blocked_los[x][y] = !map::cells[x][y].rigid->is_los_passable();
         }
-
-        check_x++;
     }
-}
 
-void run_player_fov(const bool obstructions[MAP_W][MAP_H], const Pos& origin)
-{
-    bool fov_tmp[MAP_W][MAP_H];
+    bool lit[MAP_W][MAP_H];
 
-    for (int x = 0; x < MAP_W; ++x)
+    run_fov_on_array(blocked_los, origin, lit, false);
+
+    for (int y = fov_rect.p0.y; y <= fov_rect.p1.y; ++y)
     {
-        for (int y = 0; y < MAP_H; ++y)
+        for (int x = fov_rect.p0.x; x <= fov_rect.p1.x; ++x)
         {
-            map::cells[x][y].is_seen_by_player = false;
-            fov_tmp[x][y]                    = false;
+            if (lit[x][y]) {light.set(x, y, true);}
         }
     }
+}
 
-    map::cells[origin.x][origin.y].is_seen_by_player = true;
-    fov_tmp[origin.x][origin.y] = true;
+void run_player_fov(const bool obstructions[MAP_W][MAP_H], const Pos& origin)
+{
+    bool fov_tmp[MAP_W][MAP_H];
 
-    const int R = FOV_STD_RADI_INT;
-    const int X0 = constr_in_range(0, origin.x - R, MAP_W - 1);
-    const int Y0 = constr_in_range(0, origin.y - R, MAP_H - 1);
-    const int X1 = constr_in_range(0, origin.x + R, MAP_W - 1);
-    const int Y1 = constr_in_range(0, origin.y + R, MAP_H - 1);
+    run_fov_on_array(obstructions, origin, fov_tmp, true);
 
-    for (int y = Y0; y <= Y1; ++y)
+    for (int x = 0; x < MAP_W; ++x)
     {
-        for (int x = X0; x <= X1; ++x)
+        for (int y = 0; y < MAP_H; ++y)
         {
-            check_one_cell_of_many(obstructions, Pos(x, y), origin, fov_tmp, true);
             map::cells[x][y].is_seen_by_player = fov_tmp[x][y];
         }
     }
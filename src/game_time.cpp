@@ -1,6 +1,8 @@
 #include "game_time.hpp"
 
 #include <vector>
+#include <set>
+#include <algorithm>
 #include <assert.h>
 
 #include "cmn_types.hpp"
@@ -19,23 +21,406 @@
 #include "render.hpp"
 #include "utils.hpp"
 #include "map_travel.hpp"
+#include "map_bits.hpp"
+#include "fov.hpp"
+#include "config.hpp"
 #include "item.hpp"
+#include "sdl_wrapper.hpp"
 
 using namespace std;
 
 namespace game_time
 {
 
-vector<Actor*>      actors_;
-vector<Mob*> mobs_;
+thread_local vector<Actor*>      actors_;
+thread_local vector<Mob*> mobs_;
 
 namespace
 {
 
-vector<Actor_speed>  turn_type_vector_;
-int                 cur_turn_type_pos_   = 0;
-size_t              cur_actor_index_    = 0;
-int                 turn_nr_             = 0;
+//The actors are scheduled on a sequence of steps, where the turn type of a step is the
+//step number modulo the number of turn types. Each actor is queued for the next step
+//where its speed allows it to act, ordered by step and then by the order the actors were
+//added in. The current actor is the first one in the queue.
+struct Actor_turn
+{
+    long    step;
+    long    order;
+    Actor*  actor;
+    long    first_step; //The earliest step the actor could be queued on (see nxt_step_allowed)
+
+    bool operator<(const Actor_turn& other) const
+    {
+        return step < other.step || (step == other.step && order < other.order);
+    }
+};
+
+thread_local set<Actor_turn>     turn_queue_;
+thread_local long                cur_step_           = 0;
+thread_local long                nxt_actor_order_    = 0;
+thread_local int                 turn_nr_            = 0;
+
+//Position index (see actors_at_pos and mobs_at_pos)
+thread_local vector<Actor*>      actors_at_pos_[MAP_W][MAP_H];
+thread_local vector<Mob*>        mobs_at_pos_[MAP_W][MAP_H];
+
+//The light map is updated incrementally. Each light source (actor, mob, or all burning
+//rigids together) is stored with the cells it lit at the last update, and each cell has
+//a count of the light sources lighting it. The light of an actor or mob is only computed
+//again when its origin or size has changed, or (for field of view sized light) when the
+//obstructions around it have changed.
+struct Light_src
+{
+    const void* src;
+    Pos         origin;
+    Lgt_size    size            = Lgt_size::none;
+    Fov_algo    algo;
+    int         obstr_revision;
+    Rect        area;           //All lit cells are inside this area
+    Map_bits    lit;
+    bool        is_updated;
+};
+
+thread_local vector<Light_src>   light_srcs_;
+thread_local int                 nr_lights_at_[MAP_W][MAP_H];
+thread_local int                 light_map_revision_ = 0;
+
+//Key for the light from all burning rigids (cannot be the address of an actor or mob)
+const char          burning_rigids_light_key_ = 0;
+const void* const   burning_rigids_light_src_ = &burning_rigids_light_key_;
+
+//The state above which belongs to a level, kept for the level which is not currently
+//played (see swap_lvl)
+struct Back_lvl
+{
+    vector<Actor*>      actors;
+    vector<Mob*>        mobs;
+    set<Actor_turn>     turn_queue;
+    long                cur_step            = 0;
+    long                nxt_actor_order     = 0;
+    vector<Actor*>      actors_at_pos[MAP_W][MAP_H];
+    vector<Mob*>        mobs_at_pos[MAP_W][MAP_H];
+    vector<Light_src>   light_srcs;
+    int                 nr_lights_at[MAP_W][MAP_H];
+};
+
+thread_local Back_lvl back_lvl_;
+
+template<typename T>
+void erase_from_index(vector<T*>& bucket, T* const e)
+{
+    auto it = find(begin(bucket), end(bucket), e);
+
+    if (it != end(bucket)) {bucket.erase(it);}
+}
+
+void index_actor(Actor* const actor)
+{
+    const Pos& p = actor->pos;
+
+    if (utils::is_pos_inside_map(p)) {actors_at_pos_[p.x][p.y].push_back(actor);}
+}
+
+void unindex_actor(Actor* const actor)
+{
+    const Pos& p = actor->pos;
+
+    if (utils::is_pos_inside_map(p)) {erase_from_index(actors_at_pos_[p.x][p.y], actor);}
+}
+
+Rect light_area(const Pos& origin, const Lgt_size size)
+{
+    const int R = size == Lgt_size::fov ? FOV_STD_RADI_INT : 1;
+
+    return Rect(Pos(max(0,         origin.x - R), max(0,         origin.y - R)),
+                Pos(min(MAP_W - 1, origin.x + R), min(MAP_H - 1, origin.y + R)));
+}
+
+void add_light(const Pos& origin, const Lgt_size size, Map_bits& lit)
+{
+    switch (size)
+    {
+    case Lgt_size::fov:
+        fov::add_fov_light(origin, lit);
+        break;
+
+    case Lgt_size::small:
+    {
+        const Rect area = light_area(origin, size);
+
+        for (int y = area.p0.y; y <= area.p1.y; ++y)
+        {
+            for (int x = area.p0.x; x <= area.p1.x; ++x)
+            {
+                lit.set(x, y, true);
+            }
+        }
+    } break;
+
+    case Lgt_size::none: {}
+        break;
+    }
+}
+
+void chg_nr_lights(const Light_src& light_src, const int DELTA)
+{
+    const Rect& area = light_src.area;
+
+    for (int x = area.p0.x; x <= area.p1.x; ++x)
+    {
+        for (int y = area.p0.y; y <= area.p1.y; ++y)
+        {
+            if (light_src.lit.at(x, y))
+            {
+                int& nr_lights = nr_lights_at_[x][y];
+
+                nr_lights += DELTA;
+
+                assert(nr_lights >= 0);
+
+                bool& is_lit = map::cells[x][y].is_lit;
+
+                if (is_lit != (nr_lights > 0))
+                {
+                    is_lit = !is_lit;
+                    ++light_map_revision_;
+                }
+            }
+        }
+    }
+}
+
+//Finds the light source, or adds a new one which does not light anything yet, and marks
+//it as updated
+Light_src& light_src_to_update(const void* const src)
+{
+    for (Light_src& light_src : light_srcs_)
+    {
+        if (light_src.src == src)
+        {
+            light_src.is_updated = true;
+            return light_src;
+        }
+    }
+
+    light_srcs_.push_back(Light_src());
+
+    Light_src& light_src = light_srcs_.back();
+
+    light_src.src           = src;
+    light_src.is_updated    = true;
+
+    return light_src;
+}
+
+//NOTE: Light sources which do not light anything are not updated, and are removed by
+//update_light_map
+void set_light_src(const void* const src, const Pos& origin, const Lgt_size size)
+{
+    if (size == Lgt_size::none) {return;}
+
+    Light_src&      light_src   = light_src_to_update(src);
+    const Fov_algo  algo        = config::fov_algo();
+
+    if (light_src.origin == origin && light_src.size == size)
+    {
+        if (
+            size != Lgt_size::fov ||
+            (light_src.algo == algo &&
+             !map::is_obstr_changed_in_area(light_src.area, light_src.obstr_revision)))
+        {
+            return;
+        }
+    }
+
+    chg_nr_lights(light_src, -1);
+
+    light_src.origin            = origin;
+    light_src.size              = size;
+    light_src.algo              = algo;
+    light_src.obstr_revision    = map::obstr_revision();
+    light_src.area              = light_area(origin, size);
+
+    light_src.lit.clear();
+
+    add_light(origin, size, light_src.lit);
+
+    chg_nr_lights(light_src, 1);
+}
+
+void set_burning_rigids_light(const Map_bits& lit)
+{
+    if (!lit.is_any_in_rect(map_parse::map_rect)) {return;}
+
+    Light_src& light_src = light_src_to_update(burning_rigids_light_src_);
+
+    if (light_src.lit != lit)
+    {
+        chg_nr_lights(light_src, -1);
+
+        light_src.area  = map_parse::map_rect;
+        light_src.lit   = lit;
+
+        chg_nr_lights(light_src, 1);
+    }
+}
+
+#ifndef NDEBUG
+//Checks that the active rigids are exactly the rigids found active by a full scan
+void assert_active_rigids_in_sync()
+{
+    const vector<Pos>& active_rigid_positions = map::active_rigid_positions();
+
+    size_t nr_active = 0;
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (map::cells[x][y].rigid->is_active())
+            {
+                assert(nr_active < active_rigid_positions.size());
+                assert(active_rigid_positions[nr_active] == Pos(x, y));
+
+                ++nr_active;
+            }
+        }
+    }
+
+    assert(nr_active == active_rigid_positions.size());
+}
+
+//Checks that the lit cells are the same as when adding all light from scratch
+void assert_light_map_in_sync()
+{
+    Map_bits expected_lit;
+
+    if (map_travel::map_type() != Map_type::leng)
+    {
+        for (const auto* const a : actors_) {add_light(a->pos,   a->lgt_size(), expected_lit);}
+        for (const auto* const m : mobs_)   {add_light(m->pos(), m->lgt_size(), expected_lit);}
+    }
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            const bool IS_BURNING = map::cells[x][y].rigid->burn_state() == Burn_state::burning;
+
+            if (IS_BURNING && map_travel::map_type() != Map_type::leng)
+            {
+                expected_lit.set(x, y, true);
+            }
+
+            assert(map::cells[x][y].is_lit == expected_lit.at(x, y));
+        }
+    }
+}
+#endif // NDEBUG
+
+Turn_type turn_type(const long STEP)
+{
+    return Turn_type(STEP % long(Turn_type::END));
+}
+
+//NOTE: Sluggish actors are only allowed to act on some of their turns (see can_act)
+bool is_speed_allowed_on_turn_type(const Actor_speed speed, const Turn_type type)
+{
+    switch (speed)
+    {
+    case Actor_speed::sluggish:
+    case Actor_speed::slow:
+        return type == Turn_type::slow || type == Turn_type::normal2;
+
+    case Actor_speed::normal:
+        return type != Turn_type::fast && type != Turn_type::fastest;
+
+    case Actor_speed::fast:
+        return type != Turn_type::fastest;
+
+    case Actor_speed::fastest:
+        return true;
+
+    case Actor_speed::END:
+        assert(false);
+        break;
+    }
+
+    return false;
+}
+
+long nxt_step_allowed(const Actor& actor, const long FIRST_STEP)
+{
+    const Actor_speed speed = actor.speed();
+
+    long step = FIRST_STEP;
+
+    while (!is_speed_allowed_on_turn_type(speed, turn_type(step))) {++step;}
+
+    return step;
+}
+
+//NOTE: Actors are queued again when their speed changes (see on_actor_speed_changed), the
+//speed is only checked again here in case of speed changes that were not reported
+bool can_act(const Actor& actor)
+{
+    const Actor_speed speed = actor.speed();
+
+    if (!is_speed_allowed_on_turn_type(speed, turn_type(cur_step_)))
+    {
+        return false;
+    }
+
+    return speed != Actor_speed::sluggish || rnd::fraction(2, 3);
+}
+
+//New actors are queued on the current step (after all actors added before), whether
+//they are allowed to act or not - this is checked when they are first in the queue
+void schedule_new_actor(Actor* const actor)
+{
+    turn_queue_.insert({cur_step_, nxt_actor_order_, actor, cur_step_});
+
+    ++nxt_actor_order_;
+}
+
+void unschedule_actor(const Actor* const actor)
+{
+    for (auto it = begin(turn_queue_); it != end(turn_queue_); ++it)
+    {
+        if (it->actor == actor)
+        {
+            turn_queue_.erase(it);
+            return;
+        }
+    }
+
+    assert(false);
+}
+
+//Moves the first actor in the queue to the next step where it is allowed to act
+void reschedule_first_actor()
+{
+    Actor_turn turn = *begin(turn_queue_);
+
+    turn_queue_.erase(begin(turn_queue_));
+
+    turn.first_step = cur_step_ + 1;
+    turn.step       = nxt_step_allowed(*turn.actor, turn.first_step);
+
+    turn_queue_.insert(turn);
+}
+
+void clear_index()
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            actors_at_pos_[x][y].clear();
+            mobs_at_pos_[x][y]  .clear();
+        }
+    }
+}
 
 bool is_spi_regen_this_turn(const int REGEN_N_TURNS)
 {
@@ -67,12 +452,13 @@ void run_std_turn_events()
                 map::player->tgt_ = nullptr;
             }
 
+            unindex_actor(actor);
+            unschedule_actor(actor);
+
             delete actor;
 
             actors_.erase(actors_.begin() + i);
             i--;
-
-            if (cur_actor_index_ >= actors_.size()) {cur_actor_index_ = 0;}
         }
         else  //Actor is alive or is a corpse
         {
@@ -123,15 +509,32 @@ void run_std_turn_events()
         }
     }
 
-    //New turn for rigids
-    for (int x = 0; x < MAP_W; ++x)
+    //New turn for active rigids (rigids may be activated during the loop, e.g. by fire
+    //spreading - these are visited this turn if they come later in the map order)
+    const vector<Pos>& active_rigid_positions = map::active_rigid_positions();
+
+    size_t active_rigid_idx = 0;
+
+    while (active_rigid_idx < active_rigid_positions.size())
     {
-        for (int y = 0; y < MAP_H; ++y)
+        const Pos p = active_rigid_positions[active_rigid_idx];
+
+        Rigid* const rigid = map::cells[p.x][p.y].rigid;
+
+        if (rigid->is_active())
         {
-            map::cells[x][y].rigid->on_new_turn();
+            rigid->on_new_turn();
         }
+
+        active_rigid_idx = map::nr_active_rigids_up_to(p);
     }
 
+    map::erase_inactive_rigids();
+
+#ifndef NDEBUG
+    assert_active_rigids_in_sync();
+#endif // NDEBUG
+
     //New turn for mobs (using a copied vector, since mobs may get destroyed)
     const vector<Mob*> mobs_cpy = mobs_;
 
@@ -182,9 +585,14 @@ void run_atomic_turn_events()
 
 void init()
 {
-    cur_turn_type_pos_ = cur_actor_index_ = turn_nr_ = 0;
+    cur_step_ = nxt_actor_order_ = 0;
+    turn_nr_  = 0;
+    turn_queue_.clear();
     actors_.clear();
     mobs_  .clear();
+    clear_index();
+
+    back_lvl_ = Back_lvl();
 }
 
 void cleanup()
@@ -192,10 +600,38 @@ void cleanup()
     for (Actor* a : actors_) {delete a;}
 
     actors_.clear();
+    turn_queue_.clear();
 
     for (auto* f : mobs_) {delete f;}
 
     mobs_.clear();
+
+    clear_index();
+
+    //NOTE: The back level only holds the player at this point (see map::cleanup)
+    back_lvl_ = Back_lvl();
+}
+
+void swap_lvl()
+{
+    swap(actors_,           back_lvl_.actors);
+    swap(mobs_,             back_lvl_.mobs);
+    swap(turn_queue_,       back_lvl_.turn_queue);
+    swap(cur_step_,         back_lvl_.cur_step);
+    swap(nxt_actor_order_,  back_lvl_.nxt_actor_order);
+    swap(actors_at_pos_,    back_lvl_.actors_at_pos);
+    swap(mobs_at_pos_,      back_lvl_.mobs_at_pos);
+    swap(light_srcs_,       back_lvl_.light_srcs);
+    swap(nr_lights_at_,     back_lvl_.nr_lights_at);
+
+    ++light_map_revision_;
+
+    //The player is on both levels - when a level is swapped in for the first time, the
+    //player is added to it (at the position set by map::swap_lvl)
+    if (find(begin(actors_), end(actors_), map::player) == end(actors_))
+    {
+        add_actor(map::player);
+    }
 }
 
 void store_to_save_lines(vector<string>& lines)
@@ -216,14 +652,48 @@ int turn()
 
 void mobs_at_pos(const Pos& p, vector<Mob*>& vector_ref)
 {
-    vector_ref.clear();
+    vector_ref = mobs_at_pos_[p.x][p.y];
+}
+
+const vector<Actor*>& actors_at_pos(const Pos& p)
+{
+    assert(utils::is_pos_inside_map(p));
+
+    return actors_at_pos_[p.x][p.y];
+}
+
+const vector<Mob*>& mobs_at_pos(const Pos& p)
+{
+    assert(utils::is_pos_inside_map(p));
 
-    for (auto* m : mobs_) {if (m->pos() == p) {vector_ref.push_back(m);}}
+    return mobs_at_pos_[p.x][p.y];
+}
+
+void on_actor_moved(Actor& actor, const Pos& old_pos)
+{
+    if (!utils::is_pos_inside_map(old_pos)) {return;}
+
+    vector<Actor*>& bucket = actors_at_pos_[old_pos.x][old_pos.y];
+
+    auto it = find(begin(bucket), end(bucket), &actor);
+
+    //If this fails, the actor was not added, or its position was changed without set_pos
+    assert(it != end(bucket));
+
+    if (it != end(bucket)) {bucket.erase(it);}
+
+    index_actor(&actor);
 }
 
 void add_mob(Mob* const f)
 {
     mobs_.push_back(f);
+
+    const Pos& p = f->pos();
+
+    mobs_at_pos_[p.x][p.y].push_back(f);
+
+    map::update_obstr_layers(p);
 }
 
 void erase_mob(Mob* const f, const bool DESTROY_OBJECT)
@@ -232,9 +702,15 @@ void erase_mob(Mob* const f, const bool DESTROY_OBJECT)
     {
         if (*it == f)
         {
+            const Pos p = f->pos();
+
+            erase_from_index(mobs_at_pos_[p.x][p.y], f);
+
             if (DESTROY_OBJECT) {delete f;}
 
             mobs_.erase(it);
+
+            map::update_obstr_layers(p);
             return;
         }
     }
@@ -242,15 +718,28 @@ void erase_mob(Mob* const f, const bool DESTROY_OBJECT)
 
 void erase_all_mobs()
 {
-    for (auto* m : mobs_) {delete m;}
+    vector<Pos> positions;
+
+    for (auto* m : mobs_)
+    {
+        const Pos& p = m->pos();
+
+        positions.push_back(p);
+        mobs_at_pos_[p.x][p.y].clear();
+        delete m;
+    }
 
     mobs_.clear();
+
+    for (const Pos& p : positions) {map::update_obstr_layers(p);}
 }
 
 void erase_actor_in_element(const size_t i)
 {
     if (!actors_.empty())
     {
+        unindex_actor(actors_[i]);
+        unschedule_actor(actors_[i]);
         delete actors_[i];
         actors_.erase(actors_.begin() + i);
     }
@@ -261,17 +750,28 @@ void add_actor(Actor* actor)
     //Sanity check actor inserted
     assert(utils::is_pos_inside_map(actor->pos));
     actors_.push_back(actor);
+    index_actor(actor);
+    schedule_new_actor(actor);
 }
 
 void reset_turn_type_and_actor_counters()
 {
-    cur_turn_type_pos_ = cur_actor_index_ = 0;
+    //Start over on the first turn type, with the first actor acting
+    const long NR_TURN_TYPES = long(Turn_type::END);
+
+    cur_step_ = ((cur_step_ + NR_TURN_TYPES - 1) / NR_TURN_TYPES) * NR_TURN_TYPES;
+
+    turn_queue_.clear();
+
+    nxt_actor_order_ = 0;
+
+    for (Actor* const actor : actors_) {schedule_new_actor(actor);}
 }
 
-//For every turn type step, run through all actors and let those who can act during this
-//type of turn act. When all actors who can act on this phase have acted, and if this is
-//a normal speed phase - consider it a standard turn (update properties, update features,
-//spawn more monsters etc.)
+//For every turn type step, let the actors who can act during this type of turn act (in
+//the order of the turn queue). When all actors who can act on this step have acted, and
+//if this is a normal speed step - consider it a standard turn (update properties, update
+//features, spawn more monsters etc.)
 void tick(const bool IS_FREE_TURN)
 {
     run_atomic_turn_events();
@@ -315,113 +815,180 @@ void tick(const bool IS_FREE_TURN)
 
     if (!IS_FREE_TURN)
     {
-        bool can_act = false;
+        assert(begin(turn_queue_)->actor == actor);
 
-        while (!can_act)
-        {
-            auto cur_turn_type = Turn_type(cur_turn_type_pos_);
+        reschedule_first_actor();
 
-            ++cur_actor_index_;
+        while (true)
+        {
+            const Actor_turn& nxt_turn = *begin(turn_queue_);
 
-            if (cur_actor_index_ >= actors_.size())
+            if (nxt_turn.step > cur_step_)
             {
-                cur_actor_index_ = 0;
+                //All actors have acted on this step. If this was a normal speed step,
+                //consider it a standard turn. (The standard turn events may add and
+                //remove actors, so check the queue again.)
+                const Turn_type type = turn_type(cur_step_);
 
-                ++cur_turn_type_pos_;
-
-                if (cur_turn_type_pos_ == int(Turn_type::END))
-                {
-                    cur_turn_type_pos_ = 0;
-                }
+                ++cur_step_;
 
-                if (cur_turn_type != Turn_type::fast && cur_turn_type != Turn_type::fastest)
+                if (type != Turn_type::fast && type != Turn_type::fastest)
                 {
                     run_std_turn_events();
                 }
             }
-
-            const auto speed = cur_actor()->speed();
-
-            switch (speed)
+            else if (can_act(*nxt_turn.actor))
             {
-            case Actor_speed::sluggish:
-                can_act = (cur_turn_type == Turn_type::slow ||
-                           cur_turn_type == Turn_type::normal2)
-                          && rnd::fraction(2, 3);
                 break;
+            }
+            else //Actor cannot act on this step
+            {
+                reschedule_first_actor();
+            }
+        }
+    }
+}
 
-            case Actor_speed::slow:
-                can_act = cur_turn_type == Turn_type::slow ||
-                          cur_turn_type == Turn_type::normal2;
-                break;
+void on_actor_speed_changed(const Actor& actor)
+{
+    if (turn_queue_.empty()) {return;}
 
-            case Actor_speed::normal:
-                can_act = cur_turn_type != Turn_type::fast &&
-                          cur_turn_type != Turn_type::fastest;
-                break;
+    const Actor_turn& cur_turn = *begin(turn_queue_);
 
-            case Actor_speed::fast:
-                can_act = cur_turn_type != Turn_type::fastest;
-                break;
+    //The current actor is queued with its new speed when its turn ends
+    if (cur_turn.actor == &actor) {return;}
 
-            case Actor_speed::fastest:
-                can_act = true;
-                break;
+    for (auto it = begin(turn_queue_); it != end(turn_queue_); ++it)
+    {
+        if (it->actor == &actor)
+        {
+            Actor_turn turn = *it;
+
+            turn_queue_.erase(it);
+
+            //Queue the actor as if it had the new speed when it was queued. If this is
+            //before the current actor on the current step, the actor has missed this step.
+            turn.step = nxt_step_allowed(actor, max(turn.first_step, cur_step_));
 
-            case Actor_speed::END:
+            if (cur_turn.step == cur_step_ && turn < cur_turn)
             {
-                assert(false);
-            } break;
+                turn.step = nxt_step_allowed(actor, cur_step_ + 1);
             }
+
+            turn_queue_.insert(turn);
+            return;
         }
     }
 }
 
 void update_light_map()
 {
-    bool light_tmp[MAP_W][MAP_H];
+    for (Light_src& light_src : light_srcs_) {light_src.is_updated = false;}
 
-    for (int x = 0; x < MAP_W; ++x)
+    //Do not add light on Leng
+    if (map_travel::map_type() != Map_type::leng)
     {
-        for (int y = 0; y < MAP_H; ++y)
+        for (const auto* const a : actors_) {set_light_src(a, a->pos,   a->lgt_size());}
+        for (const auto* const m : mobs_)   {set_light_src(m, m->pos(), m->lgt_size());}
+
+        //Rigids only give light by burning (lighting their own cell), and burning rigids
+        //are always active (see map::activate_rigid)
+        Map_bits lit;
+
+        for (const Pos& p : map::active_rigid_positions())
         {
-            map::cells[x][y].is_lit = light_tmp[x][y] = false;
+            if (map::cells[p.x][p.y].rigid->burn_state() == Burn_state::burning)
+            {
+                lit.set(p.x, p.y, true);
+            }
         }
+
+        set_burning_rigids_light(lit);
     }
 
-    //Do not add light on Leng
-    if (map_travel::map_type() == Map_type::leng) {return;}
+    //Remove light sources which are gone (or were not updated on Leng)
+    for (size_t i = 0; i < light_srcs_.size(); /* No increment */)
+    {
+        if (light_srcs_[i].is_updated)
+        {
+            ++i;
+        }
+        else //Not updated
+        {
+            chg_nr_lights(light_srcs_[i], -1);
+
+            light_srcs_[i] = light_srcs_.back();
+            light_srcs_.pop_back();
+        }
+    }
 
-    for (const auto* const a : actors_)  {a->add_light(light_tmp);}
+#ifndef NDEBUG
+    assert_light_map_in_sync();
+#endif // NDEBUG
+}
+
+void reset_light_map()
+{
+    light_srcs_.clear();
 
-    for (const auto* const m : mobs_)    {m->add_light(light_tmp);}
+    ++light_map_revision_;
 
     for (int x = 0; x < MAP_W; ++x)
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            auto* rigid = map::cells[x][y].rigid;
-
-            if (rigid->burn_state() == Burn_state::burning)
-            {
-                light_tmp[x][y] = true;
-            }
-
-            rigid->add_light(light_tmp);
-
-            //Copy the temp values to the real light map.
-            map::cells[x][y].is_lit = light_tmp[x][y];
+            nr_lights_at_[x][y]     = 0;
+            map::cells[x][y].is_lit = false;
         }
     }
 }
 
+int light_map_revision()
+{
+    return light_map_revision_;
+}
+
 Actor* cur_actor()
 {
-    Actor* const actor = actors_[cur_actor_index_];
+    assert(!turn_queue_.empty());
+
+    Actor* const actor = begin(turn_queue_)->actor;
 
     //Sanity check actor retrieved
     assert(utils::is_pos_inside_map(actor->pos));
     return actor;
 }
 
+void run_cur_actor_turn()
+{
+    Actor* const actor = cur_actor();
+
+    //Properties running on the actor's turn are not immediately applied
+    //on the actor, but instead placed in a buffer. This is to ensure
+    //that e.g. a property set to last one turn actually covers one turn
+    //(and not applied after the actor acts, and ends before the actor's
+    //next turn)
+    //The contents of the buffer are moved to the applied properties here
+    actor->prop_handler().apply_actor_turn_prop_buffer();
+
+    actor->update_clr();
+
+    const bool ALLOW_ACT  = actor->prop_handler().allow_act();
+    const bool IS_GIBBED  = actor->state() == Actor_state::destroyed;
+
+    if (ALLOW_ACT && !IS_GIBBED)
+    {
+        actor->on_actor_turn();
+    }
+    else //Actor cannot act
+    {
+        if (actor->is_player())
+        {
+            sdl_wrapper::sleep(DELAY_PLAYER_UNABLE_TO_ACT);
+        }
+
+        tick();
+    }
+}
+
 } //game_time
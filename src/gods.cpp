@@ -1,6 +1,7 @@
 #include "gods.hpp"
 
 #include <vector>
+#include <algorithm>
 
 #include "utils.hpp"
 
@@ -12,8 +13,9 @@ namespace gods
 namespace
 {
 
-vector<God> god_list;
-int         cur_god_elem_;
+vector<God>         god_list;
+thread_local int        cur_god_elem_;
+thread_local int        back_god_elem_  = -1; //God of the level not currently played
 
 void init_god_list()
 {
@@ -149,4 +151,14 @@ void set_no_god()
     cur_god_elem_ = -1;
 }
 
+void set_god(const God* const god)
+{
+    cur_god_elem_ = god ? int(god - god_list.data()) : -1;
+}
+
+void swap_lvl()
+{
+    swap(cur_god_elem_, back_god_elem_);
+}
+
 } //Gods
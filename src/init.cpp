@@ -27,8 +27,8 @@ using namespace std;
 namespace init
 {
 
-bool is_cheat_vision_enabled = false;
-bool quit_to_main_menu       = false;
+thread_local bool is_cheat_vision_enabled = false;
+thread_local bool quit_to_main_menu       = false;
 
 //NOTE: Initialization order matters in some cases
 void init_iO()
@@ -98,6 +98,7 @@ void init_session()
 void cleanup_session()
 {
     TRACE_FUNC_BEGIN;
+    map_travel::cleanup();
     player_spells_handling::cleanup();
     map::cleanup();
     game_time::cleanup();
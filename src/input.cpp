@@ -32,6 +32,7 @@
 #include "look.hpp"
 #include "attack.hpp"
 #include "throwing.hpp"
+#include "replay.hpp"
 #include "utils.hpp"
 
 using namespace std;
@@ -45,6 +46,9 @@ namespace
 SDL_Event sdl_event_;
 bool is_inited_ = false;
 
+//The input loop wakes up at least this often, even if there are no events
+const int INPUT_WAIT_TIMEOUT_MS = 100;
+
 void query_quit()
 {
     const vector<string> quit_choices = vector<string> {"yes", "no"};
@@ -1179,17 +1183,22 @@ Key_data input(const bool IS_O_RETURN)
         return ret;
     }
 
+    if (replay::is_playing() && replay::next_key(ret))
+    {
+        replay::on_key_read(ret);
+        return ret;
+    }
+
     SDL_StartTextInput();
 
     bool is_done = false;
 
     while (!is_done)
     {
-        sdl_wrapper::sleep(1);
-
-        const bool DID_POLL_EVENT = SDL_PollEvent(&sdl_event_);
+        //Block until there is an event (no CPU is used while waiting for the user)
+        const bool DID_GET_EVENT = SDL_WaitEventTimeout(&sdl_event_, INPUT_WAIT_TIMEOUT_MS);
 
-        if (!DID_POLL_EVENT)
+        if (!DID_GET_EVENT)
         {
             continue;
         }
@@ -1328,6 +1337,8 @@ Key_data input(const bool IS_O_RETURN)
 
     SDL_StopTextInput();
 
+    replay::on_key_read(ret);
+
     return ret;
 }
 
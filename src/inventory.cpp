@@ -19,6 +19,8 @@
 
 using namespace std;
 
+thread_local int Inventory::revision_ = 0;
+
 Inventory::Inventory()
 {
     auto set_slot = [&](const Slot_id id, const string & name)
@@ -38,6 +40,8 @@ Inventory::Inventory()
 
 Inventory::~Inventory()
 {
+    on_changed();
+
     for (size_t i = 0; i < int(Slot_id::END); ++i)
     {
         auto& slot = slots_[i];
@@ -80,6 +84,8 @@ void Inventory::store_to_save_lines(vector<string>& lines) const
 
 void Inventory::setup_from_save_lines(vector<string>& lines)
 {
+    on_changed();
+
     for (Inv_slot& slot : slots_)
     {
         //Previous item is destroyed
@@ -158,6 +164,8 @@ int Inventory::item_stack_size_in_general(const Item_id id) const
 
 void Inventory::decr_dynamite_in_general()
 {
+    on_changed();
+
     for (size_t i = 0; i < general_.size(); ++i)
     {
         if (general_[i]->data().id == Item_id::dynamite)
@@ -170,6 +178,8 @@ void Inventory::decr_dynamite_in_general()
 
 void Inventory::put_in_general(Item* item)
 {
+    on_changed();
+
     bool is_stacked = false;
 
     //If item stacks, see if there is other items of same type
@@ -203,6 +213,8 @@ void Inventory::put_in_general(Item* item)
 
 void Inventory::drop_all_non_intrinsic(const Pos& pos)
 {
+    on_changed();
+
     Item* item;
 
     //Drop from slots
@@ -267,6 +279,8 @@ bool Inventory::has_ammo_forFirearm_in_inventory()
 
 void Inventory::decr_item_in_slot(Slot_id slot_id)
 {
+    on_changed();
+
     Item* item = item_in_slot(slot_id);
     bool stack = item->data().is_stackable;
     bool delete_item = true;
@@ -290,6 +304,8 @@ void Inventory::decr_item_in_slot(Slot_id slot_id)
 
 void Inventory::remove_item_in_backpack_with_idx(const size_t IDX, const bool DELETE_ITEM)
 {
+    on_changed();
+
     if (general_.size() > IDX)
     {
         if (DELETE_ITEM)
@@ -303,6 +319,8 @@ void Inventory::remove_item_in_backpack_with_idx(const size_t IDX, const bool DE
 
 void Inventory::remove_item_in_backpack_with_ptr(Item* const item, const bool DELETE_ITEM)
 {
+    on_changed();
+
     for (auto it = begin(general_); it < end(general_); ++it)
     {
         if (*it == item)
@@ -323,6 +341,8 @@ void Inventory::remove_item_in_backpack_with_ptr(Item* const item, const bool DE
 
 void Inventory::decr_item_in_general(const size_t IDX)
 {
+    on_changed();
+
     Item* item              = general_[IDX];
     bool  is_stackable       = item->data().is_stackable;
     bool  should_delete_item  = true;
@@ -342,6 +362,8 @@ void Inventory::decr_item_in_general(const size_t IDX)
 
 void Inventory::decr_item_type_in_general(const Item_id id)
 {
+    on_changed();
+
     for (size_t i = 0; i < general_.size(); ++i)
     {
         if (general_[i]->data().id == id)
@@ -354,6 +376,8 @@ void Inventory::decr_item_type_in_general(const Item_id id)
 
 void Inventory::decr_item(Item* const item)
 {
+    on_changed();
+
     for (Inv_slot& slot : slots_)
     {
         if (slot.item == item)
@@ -375,6 +399,8 @@ void Inventory::decr_item(Item* const item)
 
 void Inventory::move_item_to_slot(Inv_slot& slot, const size_t GEN_IDX)
 {
+    on_changed();
+
     bool general_slot_exists  = GEN_IDX < general_.size();
     Item* item              = nullptr;
     Item* slot_item          = slot.item;
@@ -399,6 +425,8 @@ void Inventory::move_item_to_slot(Inv_slot& slot, const size_t GEN_IDX)
 
 void Inventory::equip_general_item(const size_t GEN_IDX, const Slot_id slot_id)
 {
+    on_changed();
+
     assert(slot_id != Slot_id::END);
 
     move_item_to_slot(slots_[int(slot_id)], GEN_IDX);
@@ -456,6 +484,8 @@ void Inventory::equip_general_item(const size_t GEN_IDX, const Slot_id slot_id)
 void Inventory::swap_wielded_and_prepared(
     const bool IS_FREE_TURN)
 {
+    on_changed();
+
     auto& slot1 = slots_[int(Slot_id::wielded)];
     auto& slot2 = slots_[int(Slot_id::wielded_alt)];
     Item* item1 = slot1.item;
@@ -470,6 +500,8 @@ void Inventory::swap_wielded_and_prepared(
 
 void Inventory::move_from_general_to_intrinsics(const size_t GEN_IDX)
 {
+    on_changed();
+
     bool general_slot_exists = GEN_IDX < general_.size();
 
     if (general_slot_exists)
@@ -487,6 +519,8 @@ void Inventory::move_from_general_to_intrinsics(const size_t GEN_IDX)
 
 bool Inventory::move_to_general(const Slot_id id)
 {
+    on_changed();
+
     assert(id != Slot_id::END);
 
     auto& slot = slots_[size_t(id)];
@@ -511,6 +545,8 @@ bool Inventory::has_item_in_slot(Slot_id id) const
 
 void Inventory::remove_without_destroying(const Inv_type inv_type, const size_t IDX)
 {
+    on_changed();
+
     if (inv_type == Inv_type::slots)
     {
         assert(IDX != int(Slot_id::END));
@@ -569,6 +605,8 @@ Item* Inventory::intrinsic_in_element(int idx) const
 
 void Inventory::put_in_intrinsics(Item* item)
 {
+    on_changed();
+
     assert(item->data().type == Item_type::melee_wpn_intr ||
            item->data().type == Item_type::ranged_wpn_intr);
 
@@ -584,6 +622,8 @@ Item* Inventory::last_item_in_general()
 
 void Inventory::put_in_slot(const Slot_id id, Item* item)
 {
+    on_changed();
+
     for (Inv_slot& slot : slots_)
     {
         if (slot.id == id)
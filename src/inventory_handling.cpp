@@ -23,15 +23,15 @@ using namespace std;
 namespace inv_handling
 {
 
-Inv_scr_id  scr_to_open_after_drop     = Inv_scr_id::END;
-Inv_slot*  equip_slot_to_open_after_drop  = nullptr;
-int       browser_idx_to_set_after_drop  = 0;
+thread_local Inv_scr_id  scr_to_open_after_drop          = Inv_scr_id::END;
+thread_local Inv_slot*   equip_slot_to_open_after_drop   = nullptr;
+thread_local int         browser_idx_to_set_after_drop   = 0;
 
 namespace
 {
 
 //The values in this vector refer to general inventory elements
-vector<size_t> general_items_to_show_;
+thread_local vector<size_t> general_items_to_show_;
 
 bool run_drop_screen(const Inv_type inv_type, const size_t ELEMENT)
 {
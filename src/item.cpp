@@ -18,6 +18,7 @@
 #include "feature_mob.hpp"
 #include "feature_rigid.hpp"
 #include "item_data.hpp"
+#include "inventory.hpp"
 
 using namespace std;
 
@@ -337,6 +338,8 @@ void Armor_asb_suit::on_equip_(const bool IS_SILENT)
     carrier_props_.push_back(new Prop_rAcid(Prop_turns::indefinite));
     carrier_props_.push_back(new Prop_rElec(Prop_turns::indefinite));
     carrier_props_.push_back(new Prop_rBreath(Prop_turns::indefinite));
+
+    Inventory::on_changed();
 }
 
 Unequip_allowed Armor_asb_suit::on_unequip_()
@@ -345,6 +348,8 @@ Unequip_allowed Armor_asb_suit::on_unequip_()
 
     carrier_props_.clear();
 
+    Inventory::on_changed();
+
     return Unequip_allowed::yes;
 }
 
@@ -353,6 +358,8 @@ void Armor_heavy_coat::on_equip_(const bool IS_SILENT)
     (void)IS_SILENT;
 
     carrier_props_.push_back(new Prop_rCold(Prop_turns::indefinite));
+
+    Inventory::on_changed();
 }
 
 Unequip_allowed Armor_heavy_coat::on_unequip_()
@@ -361,6 +368,8 @@ Unequip_allowed Armor_heavy_coat::on_unequip_()
 
     carrier_props_.clear();
 
+    Inventory::on_changed();
+
     return Unequip_allowed::yes;
 }
 
@@ -857,6 +866,8 @@ void Gas_mask::on_equip(const bool IS_SILENT)
     (void)IS_SILENT;
 
     carrier_props_.push_back(new Prop_rBreath(Prop_turns::indefinite));
+
+    Inventory::on_changed();
 }
 
 Unequip_allowed Gas_mask::on_unequip()
@@ -865,6 +876,8 @@ Unequip_allowed Gas_mask::on_unequip()
 
     carrier_props_.clear();
 
+    Inventory::on_changed();
+
     return Unequip_allowed::yes;
 }
 
@@ -111,7 +111,7 @@ Item_data_t::Item_armor_data::Item_armor_data() :
 namespace item_data
 {
 
-Item_data_t data[int(Item_id::END)];
+thread_local Item_data_t data[int(Item_id::END)];
 
 namespace
 {
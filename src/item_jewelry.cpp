@@ -11,14 +11,15 @@
 #include "text_format.hpp"
 #include "actor_factory.hpp"
 #include "feature_rigid.hpp"
+#include "inventory.hpp"
 
 using namespace std;
 
 namespace
 {
 
-Item_id  effect_list_   [int(Jewelry_effect_id::END)];
-bool    effects_known_ [int(Jewelry_effect_id::END)];
+thread_local Item_id  effect_list_   [int(Jewelry_effect_id::END)];
+thread_local bool    effects_known_ [int(Jewelry_effect_id::END)];
 
 Jewelry_effect* mk_effect(const Jewelry_effect_id id, Jewelry* const jewelry)
 {
@@ -131,6 +132,10 @@ void Jewelry_property_effect::on_equip(const bool IS_SILENT)
 
     jewelry_->carrier_props_.push_back(prop);
 
+    Inventory::on_changed();
+
+    game_time::on_actor_speed_changed(*map::player);
+
     if (!IS_SILENT)
     {
         game_time::update_light_map();
@@ -158,6 +163,10 @@ Unequip_allowed Jewelry_property_effect::on_unequip()
 
     jewelry_->carrier_props_.clear();
 
+    Inventory::on_changed();
+
+    game_time::on_actor_speed_changed(*map::player);
+
     game_time::update_light_map();
     map::player->update_fov();
     render::draw_map_and_interface();
@@ -388,7 +397,7 @@ void Jewelry_effect_conflict::on_std_turn_equiped()
 
         if (!seen_foes.empty())
         {
-            random_shuffle(begin(seen_foes), end(seen_foes));
+            rnd::shuffle(begin(seen_foes), end(seen_foes));
 
             for (Actor* actor : seen_foes)
             {
@@ -908,7 +917,7 @@ void init()
         }
     }
 
-    random_shuffle(begin(item_bucket), end(item_bucket));
+    rnd::shuffle(begin(item_bucket), end(item_bucket));
 
     vector<Jewelry_effect_id> primary_effect_bucket;
     vector<Jewelry_effect_id> secondary_effect_bucket;
@@ -927,8 +936,8 @@ void init()
         }
     }
 
-    random_shuffle(begin(primary_effect_bucket),   end(primary_effect_bucket));
-    random_shuffle(begin(secondary_effect_bucket), end(secondary_effect_bucket));
+    rnd::shuffle(begin(primary_effect_bucket),   end(primary_effect_bucket));
+    rnd::shuffle(begin(secondary_effect_bucket), end(secondary_effect_bucket));
 
     //Assuming there are more jewelry than primary or secondary effects (if this changes,
     //just add more amulets and rings to the item data)
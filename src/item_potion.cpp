@@ -551,7 +551,7 @@ namespace potion_handling
 namespace
 {
 
-vector<Potion_look> potion_looks_;
+thread_local vector<Potion_look> potion_looks_;
 
 } //namespace
 
@@ -142,7 +142,7 @@ namespace scroll_handling
 namespace
 {
 
-vector<string> false_names_;
+thread_local vector<string> false_names_;
 
 } //namespace
 
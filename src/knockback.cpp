@@ -100,7 +100,7 @@ void try_knock_back(Actor&        defender,
                     new Prop_paralyzed(Prop_turns::specific, 1), false, false);
             }
 
-            defender.pos = new_pos;
+            defender.set_pos(new_pos);
 
             if (i == KNOCK_RANGE - 1)
             {
@@ -1,5 +1,10 @@
 #include "init.hpp"
 
+#include <iostream>
+#include <sstream>
+#include <ctime>
+#include <cstring>
+
 #include <SDL.h>
 
 #include "sdl_wrapper.hpp"
@@ -8,6 +13,8 @@
 #include "main_menu.hpp"
 #include "player_bon.hpp"
 #include "bot.hpp"
+#include "bot_farm.hpp"
+#include "replay.hpp"
 #include "create_character.hpp"
 #include "actor_player.hpp"
 #include "map_gen.hpp"
@@ -23,6 +30,38 @@
 
 using namespace std;
 
+namespace
+{
+
+void print_usage()
+{
+    cout << "Usage: ia [--seed N] [--record FILE | --replay FILE]" << endl
+         << "       ia --bot [--seed N] [--runs K] [--max-dlvl D] [--workers W]"
+         << " [--threads T] [--dormant-dist N] [--report FILE]" << endl
+         << "       [--snapshot PREFIX]" << endl
+         << "  --bot         Let the bot play K runs (default 1) from the first dungeon" << endl
+         << "                level down to level D (default " << DLVL_LAST << "), without"
+         << " any user interface" << endl
+         << "  --seed N      Random seed (default based on the current time)" << endl
+         << "  --record FILE Record the seed and all keys pressed to FILE" << endl
+         << "  --replay FILE Play the game recorded in FILE (then continue from the"
+         << " keyboard)" << endl
+         << "  --workers W   Spread the runs over W processes (with seeds N, N + 1, ...)"
+         << endl
+         << "  --threads T   Run the workers on T threads in one process instead" << endl
+         << "  --dormant-dist N" << endl
+         << "                Let unaware monsters further away than N run the dormant AI"
+         << " (0 turns it off)" << endl
+         << "  --report FILE Write statistics to FILE (JSON if it ends with \".json\","
+         << " else CSV)" << endl
+         << "  --snapshot PREFIX" << endl
+         << "                Save the screen of each worker to PREFIX<seed>.ppm when its"
+         << " runs are" << endl
+         << "                finished (not with --threads)" << endl;
+}
+
+} //namespace
+
 #ifdef _WIN32
 #undef main
 #endif
@@ -30,8 +69,125 @@ int main(int argc, char* argv[])
 {
     TRACE_FUNC_BEGIN;
 
-    (void)argc;
-    (void)argv;
+    bool            is_bot_headless = false;
+    bot_farm::Opts  bot_opts;
+    string          record_path     = "";
+    string          replay_path     = "";
+
+    bot_opts.seed = time(nullptr);
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool  HAS_VAL = i + 1 < argc;
+        long        val     = 0;
+
+        if (HAS_VAL)
+        {
+            istringstream(argv[i + 1]) >> val;
+        }
+
+        if (strcmp(argv[i], "--bot") == 0)
+        {
+            is_bot_headless = true;
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && HAS_VAL && val >= 0)
+        {
+            bot_opts.seed = val;
+            ++i;
+        }
+        else if (strcmp(argv[i], "--runs") == 0 && HAS_VAL && val >= 1)
+        {
+            bot_opts.nr_runs = val;
+            ++i;
+        }
+        else if (strcmp(argv[i], "--max-dlvl") == 0 && HAS_VAL && val >= 1 && val <= DLVL_LAST)
+        {
+            bot_opts.max_dlvl = val;
+            ++i;
+        }
+        else if (strcmp(argv[i], "--workers") == 0 && HAS_VAL && val >= 1)
+        {
+            bot_opts.nr_workers = val;
+            ++i;
+        }
+        else if (strcmp(argv[i], "--threads") == 0 && HAS_VAL && val >= 1)
+        {
+            bot_opts.nr_threads = val;
+            ++i;
+        }
+        else if (strcmp(argv[i], "--dormant-dist") == 0 && HAS_VAL && val >= 0)
+        {
+            bot_opts.mon_dormant_dist = val;
+            ++i;
+        }
+        else if (strcmp(argv[i], "--report") == 0 && HAS_VAL)
+        {
+            bot_opts.report_path = argv[i + 1];
+            ++i;
+        }
+        else if (strcmp(argv[i], "--snapshot") == 0 && HAS_VAL)
+        {
+            bot_opts.snapshot_prefix = argv[i + 1];
+            ++i;
+        }
+        else if (strcmp(argv[i], "--record") == 0 && HAS_VAL)
+        {
+            record_path = argv[i + 1];
+            ++i;
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && HAS_VAL)
+        {
+            replay_path = argv[i + 1];
+            ++i;
+        }
+        else //Bad argument
+        {
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (is_bot_headless && (!record_path.empty() || !replay_path.empty()))
+    {
+        //The bot does not read any keys, so replays are only for normal games
+        print_usage();
+        return 1;
+    }
+
+    if (!bot_opts.snapshot_prefix.empty() && (!is_bot_headless || bot_opts.nr_threads > 0))
+    {
+        //The screen is shared by the whole process, so it cannot be drawn from several
+        //threads (and normal games have a window to look at)
+        print_usage();
+        return 1;
+    }
+
+    if (is_bot_headless)
+    {
+        TRACE_FUNC_END;
+
+        return bot_farm::run(bot_opts);
+    }
+
+    unsigned long seed = bot_opts.seed;
+
+    if (!replay_path.empty() && !replay::start_playback(replay_path, seed))
+    {
+        cerr << "Could not read replay file " << replay_path << endl;
+        return 1;
+    }
+
+    //Every random draw in the game comes from rnd, so the session is decided by this seed
+    //(and the keys pressed)
+    rnd::seed(seed);
+
+    TRACE << "Random seed: " << seed << endl;
+
+    if (!record_path.empty() && !replay::start_recording(record_path, seed))
+    {
+        cerr << "Could not open replay file " << record_path << endl;
+        return 1;
+    }
 
     init::init_iO();
     init::init_game();
@@ -106,34 +262,7 @@ int main(int argc, char* argv[])
             {
                 if (map::player->is_alive())
                 {
-                    Actor* const actor = game_time::cur_actor();
-
-                    //Properties running on the actor's turn are not immediately applied
-                    //on the actor, but instead placed in a buffer. This is to ensure
-                    //that e.g. a property set to last one turn actually covers one turn
-                    //(and not applied after the actor acts, and ends before the actor's
-                    //next turn)
-                    //The contents of the buffer are moved to the applied properties here
-                    actor->prop_handler().apply_actor_turn_prop_buffer();
-
-                    actor->update_clr();
-
-                    const bool ALLOW_ACT  = actor->prop_handler().allow_act();
-                    const bool IS_GIBBED  = actor->state() == Actor_state::destroyed;
-
-                    if (ALLOW_ACT && !IS_GIBBED)
-                    {
-                        actor->on_actor_turn();
-                    }
-                    else //Actor cannot act
-                    {
-                        if (actor->is_player())
-                        {
-                            sdl_wrapper::sleep(DELAY_PLAYER_UNABLE_TO_ACT);
-                        }
-
-                        game_time::tick();
-                    }
+                    game_time::run_cur_actor_turn();
                 }
                 else //Player is dead
                 {
@@ -155,6 +284,8 @@ int main(int argc, char* argv[])
     init::cleanup_game();
     init::cleanup_iO();
 
+    replay::cleanup();
+
     TRACE_FUNC_END;
 
     return 0;
@@ -2,6 +2,8 @@
 
 #include "map.hpp"
 
+#include <algorithm>
+
 #include "feature.hpp"
 #include "actor_factory.hpp"
 #include "item_factory.hpp"
@@ -11,6 +13,8 @@
 #include "item.hpp"
 #include "utils.hpp"
 #include "feature_rigid.hpp"
+#include "feature_mob.hpp"
+#include "gods.hpp"
 
 #ifdef DEMO_MODE
 #include "sdl_wrapper.hpp"
@@ -62,22 +66,86 @@ void Cell::reset()
     }
 }
 
+Lvl_layout::Lvl_layout() :
+    wall_clr(clr_gray),
+    god(nullptr)
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            rigids[x][y]    = nullptr;
+            is_dark[x][y]   = false;
+            room_map[x][y]  = nullptr;
+        }
+    }
+}
+
+Lvl_layout::~Lvl_layout()
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            delete rigids[x][y];
+        }
+    }
+
+    for (auto* room : room_list) {delete room;}
+
+    for (auto* mob : mobs) {delete mob;}
+}
+
 namespace map
 {
 
-Player*         player  = nullptr;
-int             dlvl    = 0;
-Cell            cells[MAP_W][MAP_H];
-vector<Room*>   room_list;
-Room*           room_map[MAP_W][MAP_H];
+thread_local Player*         player  = nullptr;
+thread_local int             dlvl    = 0;
+thread_local Cell            (*cells)[MAP_H] = nullptr;
+thread_local vector<Room*>   room_list;
+thread_local Room*           room_map[MAP_W][MAP_H];
 
-Clr             wall_clr;
+thread_local Clr             wall_clr;
 
 namespace
 {
 
+//Cells of the current level and the back level (see swap_lvl).
+//NOTE: The cells are used through the "cells" pointer. Each use of a thread local object
+//with a constructor in another file costs a function call, which is too slow for the cells.
+thread_local Cell cells_[2][MAP_W][MAP_H];
+
+thread_local Map_bits obstr_layers_[size_t(Obstr_layer::END)];
+thread_local int      obstr_revision_ = 0;
+
+//The obstruction revision when each cell was last updated
+thread_local int      obstr_revision_at_[MAP_W][MAP_H];
+
+//Positions of active rigids, sorted in column order (see activate_rigid)
+thread_local vector<Pos> active_rigid_positions_;
+
+//The state above which belongs to a level, kept for the level which is not currently
+//played (see swap_lvl)
+struct Back_lvl
+{
+    Cell        (*cells)[MAP_H] = nullptr;
+    Clr         wall_clr;
+    Map_bits    obstr_layers[size_t(Obstr_layer::END)];
+    vector<Pos> active_rigid_positions;
+    Pos         player_pos;
+};
+
+thread_local Back_lvl back_lvl_;
+
+bool is_before_in_col_order(const Pos& p0, const Pos& p1)
+{
+    return p0.x < p1.x || (p0.x == p1.x && p0.y < p1.y);
+}
+
 void reset_cells(const bool MAKE_STONE_WALLS)
 {
+    active_rigid_positions_.clear();
+
     for (int x = 0; x < MAP_W; ++x)
     {
         for (int y = 0; y < MAP_H; ++y)
@@ -87,26 +155,77 @@ void reset_cells(const bool MAKE_STONE_WALLS)
 
             room_map[x][y]   = nullptr;
 
-            render::render_array[x][y]              = Cell_render_data();
-            render::render_array_no_actors[x][y]    = Cell_render_data();
-
             if (MAKE_STONE_WALLS)
             {
                 put(new Wall(Pos(x, y)));
             }
+            else //No rigid here
+            {
+                update_obstr_layers(Pos(x, y));
+            }
         }
     }
+
+    game_time::reset_light_map();
+}
+
+void reset_render_arrays()
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            render::render_array[x][y]              = Cell_render_data();
+            render::render_array_no_actors[x][y]    = Cell_render_data();
+        }
+    }
+}
+
+//Deletes the monsters, rooms, mobs and features of the current level
+void clear_lvl(const bool MAKE_STONE_WALLS)
+{
+    actor_factory::delete_all_mon();
+
+    for (auto* room : room_list)
+    {
+        delete room;
+    }
+
+    room_list.clear();
+
+    reset_cells(MAKE_STONE_WALLS);
+    game_time::erase_all_mobs();
+    game_time::reset_turn_type_and_actor_counters();
+}
+
+//Deletes the monsters, mobs and features of the back level
+void clear_back_lvl()
+{
+    swap_lvl();
+
+    actor_factory::delete_all_mon();
+    game_time::erase_all_mobs();
+    reset_cells(false);
+
+    swap_lvl();
 }
 
 } //Namespace
 
 void init()
 {
+    cells = cells_[0];
+
+    back_lvl_               = Back_lvl();
+    back_lvl_.cells         = cells_[1];
+    back_lvl_.player_pos    = Pos(PLAYER_START_X, PLAYER_START_Y);
+
     dlvl = 0;
 
     room_list.clear();
 
     reset_cells(false);
+    reset_render_arrays();
 
     if (player)
     {
@@ -125,6 +244,9 @@ void init()
 
 void cleanup()
 {
+    //NOTE: This must be done while the player is set (the player is on both levels)
+    clear_back_lvl();
+
     player = nullptr; //NOTE: game_time has deleted player at this point
 
     reset_map();
@@ -137,6 +259,8 @@ void cleanup()
             cells[x][y].rigid = nullptr;
         }
     }
+
+    active_rigid_positions_.clear();
 }
 
 void store_to_save_lines(vector<string>& lines)
@@ -152,18 +276,7 @@ void setup_from_save_lines(vector<string>& lines)
 
 void reset_map()
 {
-    actor_factory::delete_all_mon();
-
-    for (auto* room : room_list)
-    {
-        delete room;
-    }
-
-    room_list.clear();
-
-    reset_cells(true);
-    game_time::erase_all_mobs();
-    game_time::reset_turn_type_and_actor_counters();
+    clear_lvl(true);
 
     //Occasionally set wall color to something unusual
     if (rnd::one_in(5))
@@ -194,6 +307,112 @@ void reset_map()
     }
 }
 
+void swap_lvl()
+{
+    swap(cells,                     back_lvl_.cells);
+    swap(wall_clr,                  back_lvl_.wall_clr);
+    swap(obstr_layers_,             back_lvl_.obstr_layers);
+    swap(active_rigid_positions_,   back_lvl_.active_rigid_positions);
+
+    //NOTE: Not set_pos - each level has its own position index, which is swapped below
+    swap(player->pos,               back_lvl_.player_pos);
+
+    game_time::swap_lvl();
+    gods::swap_lvl();
+
+    //Data cached from the obstruction layers of the other level must be rebuilt
+    ++obstr_revision_;
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            obstr_revision_at_[x][y] = obstr_revision_;
+        }
+    }
+}
+
+void enter_back_lvl()
+{
+    swap_lvl();
+
+    reset_render_arrays();
+
+    clear_back_lvl();
+}
+
+void export_layout(Lvl_layout& out)
+{
+    assert(game_time::actors_.size() == 1);
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            Cell& cell = cells[x][y];
+
+            assert(!cell.item);
+
+            out.rigids[x][y]    = cell.rigid;
+            out.is_dark[x][y]   = cell.is_dark;
+            out.room_map[x][y]  = room_map[x][y];
+
+            cell.rigid = nullptr;
+        }
+    }
+
+    out.room_list   = room_list;
+    out.mobs        = game_time::mobs_;
+    out.wall_clr    = wall_clr;
+    out.god         = gods::cur_god();
+
+    room_list.clear();
+
+    for (auto* mob : out.mobs)
+    {
+        game_time::erase_mob(mob, false);
+    }
+
+    gods::set_no_god();
+
+    reset_cells(false);
+}
+
+void import_layout(Lvl_layout& layout)
+{
+    clear_lvl(false);
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            assert(layout.rigids[x][y]);
+
+            put(layout.rigids[x][y]);
+
+            cells[x][y].is_dark = layout.is_dark[x][y];
+            room_map[x][y]      = layout.room_map[x][y];
+
+            layout.rigids[x][y]     = nullptr;
+            layout.room_map[x][y]   = nullptr;
+        }
+    }
+
+    room_list = layout.room_list;
+
+    for (auto* mob : layout.mobs)
+    {
+        game_time::add_mob(mob);
+    }
+
+    wall_clr = layout.wall_clr;
+
+    gods::set_god(layout.god);
+
+    layout.room_list.clear();
+    layout.mobs.clear();
+}
+
 Rigid* put(Rigid* const f)
 {
     assert(f);
@@ -205,6 +424,13 @@ Rigid* put(Rigid* const f)
 
     cell.rigid = f;
 
+    update_obstr_layers(p);
+
+    if (f->is_active())
+    {
+        activate_rigid(p);
+    }
+
 #ifdef DEMO_MODE
 
     if (f->id() == Feature_id::floor)
@@ -228,6 +454,105 @@ Rigid* put(Rigid* const f)
     return f;
 }
 
+const Map_bits& obstr_layer(const Obstr_layer layer)
+{
+    assert(layer != Obstr_layer::END);
+
+    return obstr_layers_[size_t(layer)];
+}
+
+void update_obstr_layers(const Pos& p)
+{
+    const Cell&     cell    = cells[p.x][p.y];
+    const Rigid*    rigid   = cell.rigid;
+
+    //Cells on the map edge, or without a rigid, block everything
+    bool is_blocking_los    = true;
+    bool is_blocking_move   = true;
+    bool is_blocking_proj   = true;
+    bool is_blocking_snd    = true;
+
+    if (rigid && utils::is_pos_inside_map(p, false))
+    {
+        is_blocking_los     = !rigid->is_los_passable();
+        is_blocking_move    = !rigid->can_move_cmn();
+        is_blocking_proj    = !rigid->is_projectile_passable();
+        is_blocking_snd     = !rigid->is_sound_passable();
+
+        for (const Mob* const mob : game_time::mobs_)
+        {
+            if (mob->pos() == p)
+            {
+                is_blocking_los     = is_blocking_los  || !mob->is_los_passable();
+                is_blocking_move    = is_blocking_move || !mob->can_move_cmn();
+                is_blocking_proj    = is_blocking_proj || !mob->is_projectile_passable();
+            }
+        }
+    }
+
+    obstr_layers_[size_t(Obstr_layer::los)]         .set(p, is_blocking_los);
+    obstr_layers_[size_t(Obstr_layer::move_cmn)]    .set(p, is_blocking_move);
+    obstr_layers_[size_t(Obstr_layer::projectiles)] .set(p, is_blocking_proj);
+    obstr_layers_[size_t(Obstr_layer::sound)]       .set(p, is_blocking_snd);
+
+    ++obstr_revision_;
+
+    obstr_revision_at_[p.x][p.y] = obstr_revision_;
+}
+
+int obstr_revision()
+{
+    return obstr_revision_;
+}
+
+bool is_obstr_changed_in_area(const Rect& area, const int REVISION)
+{
+    for (int x = area.p0.x; x <= area.p1.x; ++x)
+    {
+        for (int y = area.p0.y; y <= area.p1.y; ++y)
+        {
+            if (obstr_revision_at_[x][y] > REVISION) {return true;}
+        }
+    }
+
+    return false;
+}
+
+void activate_rigid(const Pos& p)
+{
+    auto it = lower_bound(begin(active_rigid_positions_), end(active_rigid_positions_), p,
+                          is_before_in_col_order);
+
+    if (it == end(active_rigid_positions_) || *it != p)
+    {
+        active_rigid_positions_.insert(it, p);
+    }
+}
+
+const vector<Pos>& active_rigid_positions()
+{
+    return active_rigid_positions_;
+}
+
+size_t nr_active_rigids_up_to(const Pos& p)
+{
+    return upper_bound(begin(active_rigid_positions_), end(active_rigid_positions_), p,
+                       is_before_in_col_order) - begin(active_rigid_positions_);
+}
+
+void erase_inactive_rigids()
+{
+    auto is_inactive = [](const Pos & p)
+    {
+        return !cells[p.x][p.y].rigid->is_active();
+    };
+
+    active_rigid_positions_.erase(remove_if(begin(active_rigid_positions_),
+                                            end(active_rigid_positions_),
+                                            is_inactive),
+                                  end(active_rigid_positions_));
+}
+
 void update_visual_memory()
 {
     for (int x = 0; x < MAP_W; ++x)
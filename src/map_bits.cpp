@@ -0,0 +1,224 @@
+#include "map_bits.hpp"
+
+#include <algorithm>
+#include <bitset>
+
+using namespace std;
+
+void Map_bits::clear()
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            words_[y][i] = 0;
+        }
+    }
+}
+
+void Map_bits::to_array(bool out[MAP_W][MAP_H]) const
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            out[x][y] = at(x, y);
+        }
+    }
+}
+
+void Map_bits::from_array(const bool in[MAP_W][MAP_H])
+{
+    clear();
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (in[x][y])
+            {
+                set(x, y, true);
+            }
+        }
+    }
+}
+
+void Map_bits::set_all(const bool VAL)
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            words_[y][i] = VAL ? row_mask(i) : 0;
+        }
+    }
+}
+
+void Map_bits::invert()
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            words_[y][i] = ~words_[y][i] & row_mask(i);
+        }
+    }
+}
+
+void Map_bits::or_with(const Map_bits& other)
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            words_[y][i] |= other.words_[y][i];
+        }
+    }
+}
+
+void Map_bits::and_not(const Map_bits& other)
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            words_[y][i] &= ~other.words_[y][i];
+        }
+    }
+}
+
+void Map_bits::dilate_once()
+{
+    //Horizontal pass - each row is shifted one step left and right, carrying bits
+    //across word boundaries
+    uint64_t horiz[MAP_H][WORDS_PER_ROW];
+
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            const uint64_t W = words_[y][i];
+
+            uint64_t shifted_up     = W << 1;
+            uint64_t shifted_down   = W >> 1;
+
+            if (i > 0)
+            {
+                shifted_up |= words_[y][i - 1] >> (WORD_BITS - 1);
+            }
+
+            if (i < WORDS_PER_ROW - 1)
+            {
+                shifted_down |= words_[y][i + 1] << (WORD_BITS - 1);
+            }
+
+            horiz[y][i] = (W | shifted_up | shifted_down) & row_mask(i);
+        }
+    }
+
+    //Vertical pass
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            uint64_t w = horiz[y][i];
+
+            if (y > 0)          {w |= horiz[y - 1][i];}
+
+            if (y < MAP_H - 1)  {w |= horiz[y + 1][i];}
+
+            words_[y][i] = w;
+        }
+    }
+}
+
+void Map_bits::dilate(const int DIST)
+{
+    //NOTE: Dilating by one step DIST times is the same as dilating by DIST in a square
+    for (int i = 0; i < DIST; ++i)
+    {
+        dilate_once();
+    }
+}
+
+uint64_t Map_bits::x_range_mask(const int I, const int X0, const int X1)
+{
+    const int WORD_X0 = I * WORD_BITS;
+    const int WORD_X1 = WORD_X0 + WORD_BITS - 1;
+
+    if (X1 < WORD_X0 || X0 > WORD_X1)
+    {
+        return 0;
+    }
+
+    const int BIT0 = max(X0, WORD_X0) - WORD_X0;
+    const int BIT1 = min(X1, WORD_X1) - WORD_X0;
+
+    const uint64_t FROM_BIT0 = ~uint64_t(0) << BIT0;
+
+    const uint64_t TO_BIT1 =
+        BIT1 == (WORD_BITS - 1) ? ~uint64_t(0) : ((uint64_t(1) << (BIT1 + 1)) - 1);
+
+    return FROM_BIT0 & TO_BIT1 & row_mask(I);
+}
+
+bool Map_bits::is_any_in_rect(const Rect& area, const bool VAL) const
+{
+    const int X0 = max(0, area.p0.x);
+    const int Y0 = max(0, area.p0.y);
+    const int X1 = min(MAP_W - 1, area.p1.x);
+    const int Y1 = min(MAP_H - 1, area.p1.y);
+
+    uint64_t masks[WORDS_PER_ROW];
+
+    for (int i = 0; i < WORDS_PER_ROW; ++i)
+    {
+        masks[i] = x_range_mask(i, X0, X1);
+    }
+
+    for (int y = Y0; y <= Y1; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            const uint64_t W = VAL ? words_[y][i] : ~words_[y][i];
+
+            if (W & masks[i])
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+int Map_bits::popcount() const
+{
+    int nr = 0;
+
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            nr += bitset<WORD_BITS>(words_[y][i]).count();
+        }
+    }
+
+    return nr;
+}
+
+bool Map_bits::operator==(const Map_bits& other) const
+{
+    for (int y = 0; y < MAP_H; ++y)
+    {
+        for (int i = 0; i < WORDS_PER_ROW; ++i)
+        {
+            if (words_[y][i] != other.words_[y][i])
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
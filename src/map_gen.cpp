@@ -50,7 +50,7 @@ namespace
 {
 
 //All cells marked as true in this array will be considered for door placement
-bool door_proposals[MAP_W][MAP_H];
+thread_local bool door_proposals[MAP_W][MAP_H];
 
 bool is_all_rooms_connected()
 {
@@ -934,9 +934,12 @@ void decorate()
                             {
                                 has_adj_floor = true;
 
-                                auto* adj_rigid = static_cast<Floor*>(adj_cell.rigid);
-
-                                if (adj_rigid->type_ == Floor_type::cave)
+                                //NOTE: Only check the floor type of actual floor - a trap
+                                //is not a Floor object, and casting it would read garbage
+                                if (
+                                    adj_id == Feature_id::floor &&
+                                    static_cast<Floor*>(adj_cell.rigid)->type_ ==
+                                    Floor_type::cave)
                                 {
                                     has_adj_cave_floor = true;
                                     break;
@@ -1074,7 +1077,7 @@ void move_player_to_nearest_allowed_pos()
         Is_closer_to_pos is_closer_to_origin(map::player->pos);
         sort(allowed_cells_list.begin(), allowed_cells_list.end(), is_closer_to_origin);
 
-        map::player->pos = allowed_cells_list.front();
+        map::player->set_pos(allowed_cells_list.front());
 
     }
 
@@ -1183,17 +1186,27 @@ void reveal_doors_on_path_to_stairs(const Pos& stairs_pos)
     TRACE_FUNC_END;
 }
 
+void delete_rooms()
+{
+    for (auto* r : map::room_list) {delete r;}
+
+    map::room_list.clear();
+    utils::reset_array(map::room_map);
+}
+
 } //namespace
 
 bool mk_std_lvl()
+{
+    return mk_std_lvl_layout() && populate_std_lvl();
+}
+
+bool mk_std_lvl_layout()
 {
     TRACE_FUNC_BEGIN;
 
     is_map_valid = true;
 
-    render::clear_screen();
-    render::update_screen();
-
     map::reset_map();
 
     TRACE << "Resetting helper arrays" << endl;
@@ -1417,7 +1430,22 @@ bool mk_std_lvl()
         }
     }
 
-    if (is_map_valid) {move_player_to_nearest_allowed_pos();}
+    if (!is_map_valid)
+    {
+        delete_rooms();
+    }
+
+    TRACE_FUNC_END;
+    return is_map_valid;
+}
+
+bool populate_std_lvl()
+{
+    TRACE_FUNC_BEGIN;
+
+    is_map_valid = true;
+
+    move_player_to_nearest_allowed_pos();
 
     if (is_map_valid) {populate_mon::populate_std_lvl();}
 
@@ -1445,15 +1473,23 @@ bool mk_std_lvl()
 
 #endif // DECORATE
 
-    for (auto* r : map::room_list) {delete r;}
-
-    map::room_list.clear();
-    utils::reset_array(map::room_map);
+    delete_rooms();
 
     TRACE_FUNC_END;
     return is_map_valid;
 }
 
+void mk_deferred_items()
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            map::cells[x][y].rigid->mk_items();
+        }
+    }
+}
+
 } //map_gen
 
 //=============================================================== REGION
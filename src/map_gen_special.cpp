@@ -458,7 +458,7 @@ bool mk_egypt_lvl()
 
             if (templ_cell.val == 1)
             {
-                map::player->pos = p;
+                map::player->set_pos(p);
             }
         }
     }
@@ -532,7 +532,7 @@ bool mk_leng_lvl()
             switch (templ_cell.val)
             {
             case 1:
-                map::player->pos = p;
+                map::player->set_pos(p);
                 break;
 
             case 3:
@@ -630,7 +630,7 @@ bool mk_rats_in_the_walls_lvl()
             switch (templ_cell.val)
             {
             case 1:
-                map::player->pos = p;
+                map::player->set_pos(p);
                 break;
 
             case 3:
@@ -714,7 +714,7 @@ bool mk_boss_lvl()
             switch (templ_cell.val)
             {
             case 1:
-                map::player->pos = p;
+                map::player->set_pos(p);
                 break;
 
             default: {}
@@ -775,7 +775,7 @@ bool mk_trapezohedron_lvl()
             switch (templ_cell.val)
             {
             case 1:
-                map::player->pos = p;
+                map::player->set_pos(p);
                 break;
 
             default: {}
@@ -16,7 +16,8 @@ using namespace std;
 namespace map_gen
 {
 
-bool is_map_valid = true;
+thread_local bool is_map_valid          = true;
+thread_local bool is_mk_items_deferred  = false;
 
 }
 
@@ -26,7 +27,7 @@ namespace map_gen_utils
 namespace
 {
 
-Feature_id backup[MAP_W][MAP_H];
+thread_local Feature_id backup[MAP_W][MAP_H];
 
 void floor_cells_in_room(const Room& room, const bool floor[MAP_W][MAP_H],
                          vector<Pos>& out)
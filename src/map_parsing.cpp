@@ -2,6 +2,8 @@
 
 #include <assert.h>
 #include <algorithm>
+#include <climits>
+#include <cstdlib>
 
 #include "map.hpp"
 #include "actor_player.hpp"
@@ -16,31 +18,6 @@ using namespace std;
 namespace cell_check
 {
 
-bool Blocks_los::check(const Cell& c)  const
-{
-    return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->is_los_passable();
-}
-
-bool Blocks_los::check(const Mob& f) const
-{
-    return !f.is_los_passable();
-}
-
-bool Blocks_move_cmn::check(const Cell& c) const
-{
-    return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->can_move_cmn();
-}
-
-bool Blocks_move_cmn::check(const Mob& f) const
-{
-    return !f.can_move_cmn();
-}
-
-bool Blocks_move_cmn::check(const Actor& a) const
-{
-    return a.is_alive();
-}
-
 Blocks_actor::Blocks_actor(Actor& actor, bool is_actors_blocking) :
     Check(),
     IS_ACTORS_BLOCKING_(is_actors_blocking)
@@ -48,63 +25,6 @@ Blocks_actor::Blocks_actor(Actor& actor, bool is_actors_blocking) :
     actor.prop_handler().prop_ids(actors_props_);
 }
 
-bool Blocks_actor::check(const Cell& c) const
-{
-    return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->can_move(actors_props_);
-}
-
-bool Blocks_actor::check(const Mob& f) const
-{
-    return !f.can_move(actors_props_);
-}
-
-bool Blocks_actor::check(const Actor& a) const
-{
-    return a.is_alive();
-}
-
-bool Blocks_projectiles::check(const Cell& c)  const
-{
-    return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->is_projectile_passable();
-}
-
-bool Blocks_projectiles::check(const Mob& f)  const
-{
-    return !f.is_projectile_passable();
-}
-
-bool Living_actors_adj_to_pos::check(const Actor& a) const
-{
-    if (!a.is_alive())
-    {
-        return false;
-    }
-
-    return utils::is_pos_adj(pos_, a.pos, true);
-}
-
-bool Blocks_items::check(const Cell& c)  const
-{
-    return !utils::is_pos_inside_map(c.pos, false) || !c.rigid->can_have_item();
-}
-
-bool Blocks_items::check(const Mob& f) const
-{
-    return !f.can_have_item();
-}
-
-bool Is_feature::check(const Cell& c) const
-{
-    return c.rigid->id() == feature_;
-}
-
-bool Is_any_of_features::check(const Cell& c) const
-{
-    for (auto f : features_) {if (f == c.rigid->id()) return true;}
-
-    return false;
-}
-
 bool All_adj_is_feature::check(const Cell& c) const
 {
     const int X = c.pos.x;
@@ -202,70 +122,97 @@ namespace map_parse
 
 const Rect map_rect(0, 0, MAP_W - 1, MAP_H - 1);
 
-void run(const  cell_check::Check& check,
-         bool   out[MAP_W][MAP_H],
-         const  Map_parse_mode write_rule,
-         const  Rect& area_to_check_cells)
+namespace
 {
-    assert(check.is_checking_cells()  ||
-           check.is_checking_mobs()   ||
-           check.is_checking_actors());
 
-    const bool ALLOW_WRITE_FALSE = write_rule == Map_parse_mode::overwrite;
+//Summed area table - each element holds the number of set cells in the rectangle from
+//(0, 0) to (x - 1, y - 1). The extra row and column avoids special cases at the edges.
+typedef int Sum_table[MAP_W + 1][MAP_H + 1];
+
+void mk_sum_table(const bool in[MAP_W][MAP_H], Sum_table& out)
+{
+    for (int x = 0; x <= MAP_W; ++x) {out[x][0] = 0;}
 
-    if (check.is_checking_cells())
+    for (int y = 0; y <= MAP_H; ++y) {out[0][y] = 0;}
+
+    for (int x = 1; x <= MAP_W; ++x)
     {
-        for (int x = area_to_check_cells.p0.x; x <= area_to_check_cells.p1.x; ++x)
+        for (int y = 1; y <= MAP_H; ++y)
         {
-            for (int y = area_to_check_cells.p0.y; y <= area_to_check_cells.p1.y; ++y)
-            {
-                const auto& c         = map::cells[x][y];
-                const bool  IS_MATCH  = check.check(c);
-
-                if (IS_MATCH || ALLOW_WRITE_FALSE)
-                {
-                    out[x][y] = IS_MATCH;
-                }
-            }
+            out[x][y] = in[x - 1][y - 1] + out[x - 1][y] + out[x][y - 1] - out[x - 1][y - 1];
         }
     }
+}
+
+//Number of set cells within DIST steps of the position (clamped to the map)
+int nr_in_sum_table_box(const Sum_table& t, const Pos& p, const int DIST)
+{
+    if (DIST < 0) {return 0;}
 
-    if (check.is_checking_mobs())
+    const int X0 = max(0,         p.x - DIST);
+    const int Y0 = max(0,         p.y - DIST);
+    const int X1 = min(MAP_W - 1, p.x + DIST) + 1;
+    const int Y1 = min(MAP_H - 1, p.y + DIST) + 1;
+
+    return t[X1][Y1] - t[X0][Y1] - t[X1][Y0] + t[X0][Y0];
+}
+
+} //namespace
+
+void chebyshev_dist_field(const bool in[MAP_W][MAP_H], int out[MAP_W][MAP_H])
+{
+    const int NO_CELL_DIST = MAP_W + MAP_H;
+
+    //Forward pass - propagate distances from the left and from above
+    for (int y = 0; y < MAP_H; ++y)
     {
-        for (Mob* mob : game_time::mobs_)
+        for (int x = 0; x < MAP_W; ++x)
         {
-            const Pos& p = mob->pos();
+            if (in[x][y])
+            {
+                out[x][y] = 0;
+                continue;
+            }
 
-            if (utils::is_pos_inside(p, area_to_check_cells))
+            int d = NO_CELL_DIST;
+
+            if (x > 0)
             {
-                const bool IS_MATCH = check.check(*mob);
+                d = min(d, out[x - 1][y] + 1);
+            }
 
-                if (IS_MATCH || ALLOW_WRITE_FALSE)
-                {
-                    bool& v = out[p.x][p.y];
+            if (y > 0)
+            {
+                d = min(d, out[x][y - 1] + 1);
 
-                    if (!v) {v = IS_MATCH;}
-                }
+                if (x > 0)          {d = min(d, out[x - 1][y - 1] + 1);}
+
+                if (x < MAP_W - 1)  {d = min(d, out[x + 1][y - 1] + 1);}
             }
+
+            out[x][y] = d;
         }
     }
 
-    if (check.is_checking_actors())
+    //Backward pass - propagate distances from the right and from below
+    for (int y = MAP_H - 1; y >= 0; --y)
     {
-        for (Actor* actor : game_time::actors_)
+        for (int x = MAP_W - 1; x >= 0; --x)
         {
-            const Pos& p = actor->pos;
+            int& d = out[x][y];
 
-            if (utils::is_pos_inside(p, area_to_check_cells))
+            if (x < MAP_W - 1)
             {
-                const bool IS_MATCH = check.check(*actor);
+                d = min(d, out[x + 1][y] + 1);
+            }
 
-                if (IS_MATCH || ALLOW_WRITE_FALSE)
-                {
-                    bool& v = out[p.x][p.y];
+            if (y < MAP_H - 1)
+            {
+                d = min(d, out[x][y + 1] + 1);
 
-                    if (!v) {v = IS_MATCH;}
-                }
+                if (x < MAP_W - 1)  {d = min(d, out[x + 1][y + 1] + 1);}
+
+                if (x > 0)          {d = min(d, out[x - 1][y + 1] + 1);}
             }
         }
     }
@@ -276,44 +223,52 @@ void cells_within_dist_of_others(const bool in[MAP_W][MAP_H], bool out[MAP_W][MA
 {
     assert(in != out);
 
+    //A cell is set if any other cell is exactly on the border of a square around it,
+    //at one of the distances in the interval. The squares are clamped to the map, so
+    //a cell on the map edge is on the border of every square reaching the edge.
+    //This means that:
+    // * Cells on the map edge count if they are within the upper distance
+    // * All other cells count if they are between the lower and upper distance
+    //Both are answered in constant time per cell from summed area tables.
+    bool in_map_edge[MAP_W][MAP_H];
+    bool in_inner[MAP_W][MAP_H];
+
     for (int x = 0; x < MAP_W; ++x)
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            out[x][y] = false;
+            const bool IS_ON_EDGE = !utils::is_pos_inside_map(Pos(x, y), false);
+
+            in_map_edge[x][y]   = in[x][y] && IS_ON_EDGE;
+            in_inner[x][y]      = in[x][y] && !IS_ON_EDGE;
         }
     }
 
-    for (int y_outer = 0; y_outer < MAP_H; y_outer++)
+    Sum_table map_edge_sums;
+    Sum_table inner_sums;
+
+    mk_sum_table(in_map_edge,  map_edge_sums);
+    mk_sum_table(in_inner,     inner_sums);
+
+    const int LOWER = dist_interval.lower;
+    const int UPPER = dist_interval.upper;
+
+    for (int x = 0; x < MAP_W; ++x)
     {
-        for (int x_outer = 0; x_outer < MAP_W; x_outer++)
+        for (int y = 0; y < MAP_H; ++y)
         {
-            if (!out[x_outer][y_outer])
+            if (LOWER > UPPER)
             {
-                for (int d = dist_interval.lower; d <= dist_interval.upper; d++)
-                {
-                    Pos p0(max(0,         x_outer - d), max(0,         y_outer - d));
-                    Pos p1(min(MAP_W - 1, x_outer + d), min(MAP_H - 1, y_outer + d));
+                out[x][y] = false;
+                continue;
+            }
 
-                    for (int x = p0.x; x <= p1.x; ++x)
-                    {
-                        if (in[x][p0.y] || in[x][p1.y])
-                        {
-                            out[x_outer][y_outer] = true;
-                            break;
-                        }
-                    }
+            const Pos p(x, y);
 
-                    for (int y = p0.y; y <= p1.y; ++y)
-                    {
-                        if (in[p0.x][y] || in[p1.x][y])
-                        {
-                            out[x_outer][y_outer] = true;
-                            break;
-                        }
-                    }
-                }
-            }
+            const int NR_INNER = nr_in_sum_table_box(inner_sums, p, UPPER) -
+                                 nr_in_sum_table_box(inner_sums, p, LOWER - 1);
+
+            out[x][y] = NR_INNER > 0 || nr_in_sum_table_box(map_edge_sums, p, UPPER) > 0;
         }
     }
 }
@@ -334,6 +289,13 @@ bool is_val_in_area(const Rect& area, const bool in[MAP_W][MAP_H],
     return false;
 }
 
+bool is_val_in_area(const Rect& area, const Map_bits& in, const bool VAL)
+{
+    assert(utils::is_area_inside_map(area));
+
+    return in.is_any_in_rect(area, VAL);
+}
+
 void append(bool base[MAP_W][MAP_H], const bool append[MAP_W][MAP_H])
 {
     for (int x = 0; x < MAP_W; ++x)
@@ -345,6 +307,11 @@ void append(bool base[MAP_W][MAP_H], const bool append[MAP_W][MAP_H])
     }
 }
 
+void append(Map_bits& base, const Map_bits& append)
+{
+    base.or_with(append);
+}
+
 void expand(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H],
             const Rect& area_allowed_to_modify)
 {
@@ -393,44 +360,25 @@ void expand(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H],
 
 void expand(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H], const int DIST)
 {
+    int dist_field[MAP_W][MAP_H];
+
+    chebyshev_dist_field(in, dist_field);
+
     for (int x = 0; x < MAP_W; ++x)
     {
         for (int y = 0; y < MAP_H; ++y)
         {
-            out[x][y] = false;
-
-            const int X0 = x - DIST;
-            const int Y0 = y - DIST;
-            const int X1 = x + DIST;
-            const int Y1 = y + DIST;
-
-            const int CMP_X0 = X0 < 0 ? 0 : X0;
-            const int CMP_Y0 = Y0 < 0 ? 0 : Y0;
-            const int CMP_X1 = X1 > MAP_W - 1 ? MAP_W - 1 : X1;
-            const int CMP_Y1 = Y1 > MAP_H - 1 ? MAP_H - 1 : Y1;
-
-            for (int cmp_y = CMP_Y0; cmp_y <= CMP_Y1; ++cmp_y)
-            {
-                bool is_found = false;
-
-                for (int cmp_x = CMP_X0; cmp_x <= CMP_X1; ++cmp_x)
-                {
-                    if (in[cmp_x][cmp_y])
-                    {
-                        is_found = out[x][y] = true;
-                        break;
-                    }
-                }
-
-                if (is_found)
-                {
-                    break;
-                }
-            }
+            out[x][y] = dist_field[x][y] <= DIST;
         }
     }
 }
 
+void expand(const Map_bits& in, Map_bits& out, const int DIST)
+{
+    out = in;
+    out.dilate(DIST);
+}
+
 bool is_map_connected(const bool blocked[MAP_W][MAP_H])
 {
     Pos origin(-1, -1);
@@ -487,105 +435,189 @@ bool Is_closer_to_pos::operator()(const Pos& p1, const Pos& p2)
 namespace flood_fill
 {
 
-void run(const Pos& p0,
-         const bool blocked[MAP_W][MAP_H],
-         int out[MAP_W][MAP_H],
-         int travel_lmt,
-         const Pos& p1,
-         const bool ALLOW_DIAGONAL)
+namespace
 {
-    utils::reset_array(out);
 
-    vector<Pos> positions;
-    positions.clear();
+//Cells are stored by index (x * MAP_H + y, the same layout as the map arrays), so that
+//the neighbours of a cell are at fixed offsets. The map edge is never entered, so it
+//works as a sentinel border - the neighbours of every cell inside the edge are on the
+//map, and need no bounds checks.
+const int NR_CELLS = MAP_W * MAP_H;
 
-    unsigned int  nr_elements_to_skip   = 0;
-    int           cur_val               = 0;
-    bool          path_exists           = true;
-    bool          is_at_tgt          = false;
-    bool          is_stopping_at_p1     = p1.x != -1;
-    const         Rect bounds(Pos(1, 1), Pos(MAP_W - 2, MAP_H - 2));
-    Pos           cur_pos(p0);
+//Open cells (inside the map edge, not blocked, and not yet reached)
+thread_local bool is_open_[NR_CELLS];
 
-    vector<Pos> dirs {Pos(0, -1), Pos(-1, 0), Pos(0, 1), Pos(1, 0)};
+//Each cell is queued at most once (and origins are never queued again), so the queue
+//can never hold more than the number of origins plus the number of cells
+thread_local int queue_[NR_CELLS * 2];
 
-    if (ALLOW_DIAGONAL)
+bool is_on_map_edge(const int X, const int Y)
+{
+    return X <= 0 || Y <= 0 || X >= MAP_W - 1 || Y >= MAP_H - 1;
+}
+
+void run_from_origins(const Pos* const origins,
+                      const size_t NR_ORIGINS,
+                      const bool blocked[MAP_W][MAP_H],
+                      int out[MAP_W][MAP_H],
+                      const int travel_lmt,
+                      const Pos& p1,
+                      const bool ALLOW_DIAGONAL)
+{
+    int* const dist = &out[0][0];
+
+    fill(dist, dist + NR_CELLS, 0);
+
+    const bool* const blocked_flat = &blocked[0][0];
+
+    for (int i = 0; i < NR_CELLS; ++i)
     {
-        dirs.push_back(Pos(-1, -1));
-        dirs.push_back(Pos(-1, 1));
-        dirs.push_back(Pos(1, -1));
-        dirs.push_back(Pos(1, 1));
+        is_open_[i] = !blocked_flat[i];
     }
 
-    bool done = false;
+    //Close the map edge (sentinel border)
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        is_open_[x * MAP_H]             = false;
+        is_open_[x * MAP_H + MAP_H - 1] = false;
+    }
 
-    while (!done)
+    for (int y = 0; y < MAP_H; ++y)
     {
+        is_open_[y]                         = false;
+        is_open_[(MAP_W - 1) * MAP_H + y]   = false;
+    }
 
-        for (const Pos& d : dirs)
-        {
-            if ((d != 0))
-            {
-                const Pos new_pos(cur_pos + d);
+    //Cardinal directions first, then diagonals
+    const Pos dirs[8] =
+    {
+        Pos(0, -1), Pos(-1, 0), Pos(0, 1), Pos(1, 0),
+        Pos(-1, -1), Pos(-1, 1), Pos(1, -1), Pos(1, 1)
+    };
 
-                if (
-                    !blocked[new_pos.x][new_pos.y]          &&
-                    utils::is_pos_inside(new_pos, bounds)   &&
-                    out[new_pos.x][new_pos.y] == 0          &&
-                    new_pos != p0)
-                {
-                    cur_val = out[cur_pos.x][cur_pos.y];
+    const int NR_DIRS = ALLOW_DIAGONAL ? 8 : 4;
 
-                    if (cur_val < travel_lmt) {out[new_pos.x][new_pos.y] = cur_val + 1;}
+    int offsets[8];
 
-                    if (is_stopping_at_p1 && cur_pos == p1 - d)
-                    {
-                        is_at_tgt = true;
-                        break;
-                    }
+    for (int i = 0; i < NR_DIRS; ++i)
+    {
+        offsets[i] = dirs[i].x * MAP_H + dirs[i].y;
+    }
 
-                    if (!is_stopping_at_p1 || !is_at_tgt)
-                    {
-                        positions.push_back(new_pos);
-                    }
-                }
-            }
-        }
+    const bool  IS_STOPPING_AT_P1   = p1.x != -1;
+    const int   P1_IDX              = IS_STOPPING_AT_P1 ? (p1.x * MAP_H + p1.y) : -1;
 
-        if (is_stopping_at_p1)
-        {
-            if (positions.size() == nr_elements_to_skip)  {path_exists = false;}
+    assert(NR_ORIGINS <= size_t(NR_CELLS));
 
-            if (is_at_tgt || !path_exists)             {done = true;}
-        }
-        else if (positions.size() == nr_elements_to_skip)
-        {
-            done = true;
-        }
+    int queue_start = 0;
+    int queue_end   = 0;
+
+    for (size_t i = 0; i < NR_ORIGINS; ++i)
+    {
+        const int IDX = origins[i].x * MAP_H + origins[i].y;
+
+        queue_[queue_end++] = IDX;
+
+        is_open_[IDX] = false;
+    }
+
+    while (queue_start != queue_end)
+    {
+        const bool  IS_ORIGIN   = size_t(queue_start) < NR_ORIGINS;
+        const int   CUR_IDX     = queue_[queue_start++];
+        const int   CUR_VAL     = dist[CUR_IDX];
 
-        if (cur_val == travel_lmt) {done = true;}
+        if (CUR_VAL >= travel_lmt) {break;}
 
-        if (!is_stopping_at_p1 || !is_at_tgt)
+        //Only an origin can be on the map edge - then the sentinel border does not
+        //protect against stepping outside the map
+        const bool IS_CUR_ON_EDGE =
+            IS_ORIGIN && is_on_map_edge(CUR_IDX / MAP_H, CUR_IDX % MAP_H);
+
+        for (int i = 0; i < NR_DIRS; ++i)
         {
-            if (positions.size() == nr_elements_to_skip)
-            {
-                path_exists = false;
-            }
-            else
+            if (IS_CUR_ON_EDGE)
             {
-                cur_pos = positions[nr_elements_to_skip];
-                nr_elements_to_skip++;
+                const Pos adj_pos(CUR_IDX / MAP_H + dirs[i].x, CUR_IDX % MAP_H + dirs[i].y);
+
+                if (!utils::is_pos_inside_map(adj_pos)) {continue;}
             }
+
+            const int ADJ_IDX = CUR_IDX + offsets[i];
+
+            if (!is_open_[ADJ_IDX]) {continue;}
+
+            is_open_[ADJ_IDX]       = false;
+            dist[ADJ_IDX]           = CUR_VAL + 1;
+            queue_[queue_end++]     = ADJ_IDX;
+
+            if (ADJ_IDX == P1_IDX) {return;}
         }
     }
 }
 
+} //namespace
+
+void run(const Pos& p0,
+         const bool blocked[MAP_W][MAP_H],
+         int out[MAP_W][MAP_H],
+         int travel_lmt,
+         const Pos& p1,
+         const bool ALLOW_DIAGONAL)
+{
+    run_from_origins(&p0, 1, blocked, out, travel_lmt, p1, ALLOW_DIAGONAL);
+}
+
+void run(const vector<Pos>& origins,
+         const bool blocked[MAP_W][MAP_H],
+         int out[MAP_W][MAP_H],
+         int travel_lmt,
+         const Pos& p1,
+         const bool ALLOW_DIAGONAL)
+{
+    run_from_origins(origins.data(), origins.size(), blocked, out, travel_lmt, p1,
+                     ALLOW_DIAGONAL);
+}
+
 } //Flood_fill
 
 //------------------------------------------------------------ PATHFINDER
 namespace path_find
 {
 
+namespace
+{
+
+//Search state for the A* search below. This is kept between calls to avoid allocating
+//anything per search - the cost values are only valid for the cells stamped with the
+//current search number, so nothing needs to be reset between searches.
+//
+//Since each step costs one, and the heuristic never changes by more than one per step,
+//a cell reached from a cell with estimated total cost F gets an estimate of F, F + 1,
+//or F + 2. So instead of a heap, the open cells are kept in three buckets (stacks),
+//indexed by estimated cost modulo three.
+struct Open_node
+{
+    int g;
+    Pos p;
+};
+
+const int NR_BUCKETS = 3;
+
+//A cell can only be in a bucket once (same estimate means same cost)
+thread_local Open_node   open_[NR_BUCKETS][MAP_W * MAP_H];
+thread_local size_t      nr_open_[NR_BUCKETS];
+thread_local int         cost_[MAP_W][MAP_H];
+thread_local int         search_nr_at_[MAP_W][MAP_H];
+thread_local int         cur_search_nr_ = 0;
+
+bool has_cost(const Pos& p)
+{
+    return search_nr_at_[p.x][p.y] == cur_search_nr_;
+}
+
+} //namespace
+
 void run(const Pos& p0, const Pos& p1, bool blocked[MAP_W][MAP_H], vector<Pos>& out,
          const bool ALLOW_DIAGONAL, const bool RANDOMIZE_STEP_CHOICES)
 {
@@ -597,85 +629,167 @@ void run(const Pos& p0, const Pos& p1, bool blocked[MAP_W][MAP_H], vector<Pos>&
         return;
     }
 
-    int flood[MAP_W][MAP_H];
-    flood_fill::run(p0, blocked, flood, 10000, p1, ALLOW_DIAGONAL);
+    const Rect bounds(Pos(1, 1), Pos(MAP_W - 2, MAP_H - 2));
 
-    if (flood[p1.x][p1.y] == 0)
+    if (!utils::is_pos_inside(p1, bounds) || blocked[p1.x][p1.y])
     {
-        //No path exists
+        //Target cannot be reached
         return;
     }
 
+    if (cur_search_nr_ == INT_MAX)
+    {
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                search_nr_at_[x][y] = 0;
+            }
+        }
+
+        cur_search_nr_ = 0;
+    }
+
+    ++cur_search_nr_;
+
     const vector<Pos>& dirs =  ALLOW_DIAGONAL ?
                                dir_utils::dir_list :
                                dir_utils::cardinal_list;
 
     const size_t NR_DIRS = dirs.size();
 
-    vector<bool> valid_offsets(NR_DIRS, false); //Corresponds to the elements in "dirs"
+    //Admissible (and consistent) estimate of the remaining cost
+    auto heuristic = [&](const Pos & p)
+    {
+        const int DX = abs(p.x - p1.x);
+        const int DY = abs(p.y - p1.y);
 
-    //The path length will be equal to the flood value at the target cell, so we can
-    //reserve that many elements.
-    out.reserve(flood[p1.x][p1.y]);
+        return ALLOW_DIAGONAL ? max(DX, DY) : (DX + DY);
+    };
 
-    Pos cur_pos(p1);
-    out.push_back(cur_pos);
+    for (int i = 0; i < NR_BUCKETS; ++i) {nr_open_[i] = 0;}
 
-    while (true)
+    int     cur_f       = heuristic(p0);
+    size_t  nr_open_tot = 1;
+
+    cost_[p0.x][p0.y]               = 0;
+    search_nr_at_[p0.x][p0.y]       = cur_search_nr_;
+    open_[cur_f % NR_BUCKETS][0]    = {0, p0};
+    nr_open_[cur_f % NR_BUCKETS]    = 1;
+
+    int path_len = -1;
+
+    //NOTE: The search does not stop at the first path found, but continues until all
+    //cells which could be on *any* shortest path have their final cost. The step choices
+    //below then match those of a full flood fill from the origin.
+    while (nr_open_tot > 0)
     {
-        Pos adj_pos;
+        size_t& nr_in_bucket = nr_open_[cur_f % NR_BUCKETS];
 
-        //Find valid offsets, and check if origin is reached
-        for (size_t i = 0; i < NR_DIRS; ++i)
+        if (nr_in_bucket == 0)
         {
-            const Pos& d(dirs[i]);
+            ++cur_f;
 
-            adj_pos = cur_pos + d;
+            if (path_len != -1 && cur_f > path_len) {break;}
 
-            if (adj_pos == p0)
-            {
-                //Origin reached
-                return;
-            }
+            continue;
+        }
 
-            const bool IS_INSIDE_MAP  = utils::is_pos_inside_map(adj_pos);
+        const Open_node node = open_[cur_f % NR_BUCKETS][--nr_in_bucket];
 
-            const int VAL_AT_ADJ      = IS_INSIDE_MAP ? flood[adj_pos.x][adj_pos.y] : 0;
-            const int VAL_AT_CUR      =                 flood[cur_pos.x][cur_pos.y];
+        --nr_open_tot;
 
-            valid_offsets[i]           = VAL_AT_ADJ < VAL_AT_CUR && VAL_AT_ADJ != 0;
+        if (node.g > cost_[node.p.x][node.p.y])
+        {
+            //A cheaper way to this cell was found after this node was added
+            continue;
         }
 
-        //Set the adjacent position to one of the valid offset
-        //Either pick one of the valid offsets at random, or iterate over an offset list
-        if (RANDOMIZE_STEP_CHOICES)
+        for (size_t i = 0; i < NR_DIRS; ++i)
         {
-            vector<Pos> adj_pos_bucket;
+            const Pos adj_pos(node.p + dirs[i]);
+
+            //NOTE: The bounds check is written out here, since this is the hot loop
+            if (
+                adj_pos.x < bounds.p0.x || adj_pos.x > bounds.p1.x     ||
+                adj_pos.y < bounds.p0.y || adj_pos.y > bounds.p1.y     ||
+                blocked[adj_pos.x][adj_pos.y]                          ||
+                adj_pos == p0)
+            {
+                continue;
+            }
+
+            const int G = node.g + 1;
 
-            for (size_t i = 0; i < NR_DIRS; ++i)
+            if (has_cost(adj_pos) && cost_[adj_pos.x][adj_pos.y] <= G)
             {
-                if (valid_offsets[i])
-                {
-                    adj_pos_bucket.push_back(cur_pos + dirs[i]);
-                }
+                continue;
             }
 
-            assert(!adj_pos_bucket.empty());
+            cost_[adj_pos.x][adj_pos.y]          = G;
+            search_nr_at_[adj_pos.x][adj_pos.y]  = cur_search_nr_;
 
-            adj_pos = adj_pos_bucket[rnd::range(0, adj_pos_bucket.size() - 1)];
+            if (adj_pos == p1)
+            {
+                path_len = G;
+            }
+            else //Not target
+            {
+                const int F = G + heuristic(adj_pos);
+
+                assert(F >= cur_f && F <= cur_f + 2);
+
+                open_[F % NR_BUCKETS][nr_open_[F % NR_BUCKETS]++] = {G, adj_pos};
+
+                ++nr_open_tot;
+            }
         }
-        else //Do not randomize step choices - iterate over offset list
+    }
+
+    if (path_len == -1)
+    {
+        //No path exists
+        return;
+    }
+
+    out.reserve(path_len);
+
+    Pos cur_pos(p1);
+    out.push_back(cur_pos);
+
+    Pos adj_pos_bucket[8];
+
+    while (true)
+    {
+        const int COST_AT_CUR = cost_[cur_pos.x][cur_pos.y];
+
+        size_t nr_valid = 0;
+
+        //Find valid steps, and check if origin is reached
+        for (size_t i = 0; i < NR_DIRS; ++i)
         {
-            for (size_t i = 0; i < NR_DIRS; ++i)
+            const Pos adj_pos(cur_pos + dirs[i]);
+
+            if (adj_pos == p0)
             {
-                if (valid_offsets[i])
-                {
-                    adj_pos = {cur_pos + dirs[i]};
-                    break;
-                }
+                //Origin reached
+                return;
+            }
+
+            if (has_cost(adj_pos) && cost_[adj_pos.x][adj_pos.y] == COST_AT_CUR - 1)
+            {
+                adj_pos_bucket[nr_valid++] = adj_pos;
             }
         }
 
+        assert(nr_valid > 0);
+
+        //Either pick one of the valid steps at random, or take the first one in the
+        //offset list
+        const Pos& adj_pos = RANDOMIZE_STEP_CHOICES ?
+                             adj_pos_bucket[rnd::range(0, nr_valid - 1)] :
+                             adj_pos_bucket[0];
+
         out.push_back(adj_pos);
 
         cur_pos = adj_pos;
@@ -3,10 +3,11 @@
 #include "init.hpp"
 
 #include <list>
-
-#ifndef NDEBUG
 #include <chrono>
-#endif // NDEBUG
+#include <future>
+#include <memory>
+#include <climits>
+#include <assert.h>
 
 #include "map.hpp"
 #include "map_gen.hpp"
@@ -21,21 +22,72 @@ using namespace std;
 namespace map_travel
 {
 
-vector<map_data> map_list;
+thread_local vector<map_data> map_list;
 
 namespace
 {
 
+thread_local long    nr_lvl_build_attempts_  = 0;
+thread_local double  lvl_build_seconds_      = 0.0;
+
+//The layout of the next level (if it is a standard level) is made on a worker thread
+//while the current level is played, see prefetch_nxt_lvl. The worker runs a session of
+//its own, seeded from this session, so the layout only depends on the seed and DLVL -
+//not on how long the worker takes. Going to the next level waits for the worker, then
+//populates the layout and swaps it in on this thread.
+struct Nxt_lvl_layout
+{
+    Lvl_layout  layout;
+    int         dlvl        = 0;
+    int         nr_attempts = 0;
+};
+
+thread_local future<Nxt_lvl_layout*> nxt_lvl_layout_;
+
+//Runs on the worker thread
+Nxt_lvl_layout* mk_nxt_lvl_layout(const int DLVL, const unsigned long SEED)
+{
+    init::init_session();
+
+    rnd::seed(SEED);
+
+    map::dlvl                       = DLVL;
+    map_gen::is_mk_items_deferred   = true;
+
+    auto* const nxt = new Nxt_lvl_layout;
+
+    nxt->dlvl = DLVL;
+
+    do
+    {
+        ++nxt->nr_attempts;
+    }
+    while (!map_gen::mk_std_lvl_layout());
+
+    map::export_layout(nxt->layout);
+
+    init::cleanup_session();
+
+    return nxt;
+}
+
+//Waits for the worker (if started), and discards the layout
+void discard_nxt_lvl_layout()
+{
+    if (nxt_lvl_layout_.valid())
+    {
+        delete nxt_lvl_layout_.get();
+    }
+}
+
 void mk_lvl(const Map_type& map_type)
 {
     TRACE_FUNC_BEGIN;
 
     bool is_lvl_built = false;
 
-#ifndef NDEBUG
     int   nr_attempts  = 0;
     auto  start_time   = chrono::steady_clock::now();
-#endif
 
     //TODO: When the map is invalid, any unique items spawned are lost forever.
     //Currently, the only effect of this should be that slightly fewever unique items
@@ -44,9 +96,7 @@ void mk_lvl(const Map_type& map_type)
 
     while (!is_lvl_built)
     {
-#ifndef NDEBUG
         ++nr_attempts;
-#endif
 
         switch (map_type)
         {
@@ -66,21 +116,83 @@ void mk_lvl(const Map_type& map_type)
         }
     }
 
-#ifndef NDEBUG
     auto diff_time = chrono::steady_clock::now() - start_time;
 
+    nr_lvl_build_attempts_  += nr_attempts;
+    lvl_build_seconds_      += chrono::duration<double>(diff_time).count();
+
     TRACE << "map built after   " << nr_attempts << " attempt(s). " << endl
           << "Total time taken: "
           << chrono::duration <double, milli> (diff_time).count() << " ms" << endl;
-#endif
+
+    TRACE_FUNC_END;
+}
+
+//Builds the level which is entered next into the back level of the map (see
+//map::swap_lvl), with the player arriving near the position it leaves from
+void build_back_lvl(const Map_type map_type)
+{
+    TRACE_FUNC_BEGIN;
+
+    const Pos origin = map::player->pos;
+
+    bool is_lvl_built = false;
+
+    auto start_time = chrono::steady_clock::now();
+
+    //NOTE: This waits for the worker if it has not finished yet
+    unique_ptr<Nxt_lvl_layout> nxt(nxt_lvl_layout_.valid() ?
+                                   nxt_lvl_layout_.get() : nullptr);
+
+    map::swap_lvl();
+
+    map::player->set_pos(origin);
+
+    if (nxt)
+    {
+        assert(map_type == Map_type::std);
+        assert(nxt->dlvl == map::dlvl);
+
+        map::import_layout(nxt->layout);
+        map_gen::mk_deferred_items();
+
+        is_lvl_built = map_gen::populate_std_lvl();
+
+        auto diff_time = chrono::steady_clock::now() - start_time;
+
+        nr_lvl_build_attempts_  += nxt->nr_attempts;
+        lvl_build_seconds_      += chrono::duration<double>(diff_time).count();
+
+        TRACE << "Layout made by worker after " << nxt->nr_attempts << " attempt(s), "
+              << (is_lvl_built ? "populated" : "failed to populate") << endl;
+    }
+
+    if (!is_lvl_built)
+    {
+        mk_lvl(map_type);
+    }
+
+    map::swap_lvl();
 
     TRACE_FUNC_END;
 }
 
 } //namespace
 
+long nr_lvl_build_attempts()
+{
+    return nr_lvl_build_attempts_;
+}
+
+double lvl_build_seconds()
+{
+    return lvl_build_seconds_;
+}
+
 void init()
 {
+    discard_nxt_lvl_layout();
+
     //Forest + dungeon + boss + trapezohedron
     const size_t NR_LVL_TOT = DLVL_LAST + 3;
 
@@ -103,6 +215,11 @@ void init()
     map_list[DLVL_LAST + 2] = {Map_type::trapezohedron,  Is_main_dungeon::yes};
 }
 
+void cleanup()
+{
+    discard_nxt_lvl_layout();
+}
+
 void store_to_save_lines(std::vector<std::string>& lines)
 {
     lines.push_back(to_str(map_list.size()));
@@ -132,6 +249,26 @@ void setup_from_save_lines(std::vector<std::string>& lines)
     }
 }
 
+void prefetch_nxt_lvl()
+{
+    if (
+        nxt_lvl_layout_.valid() ||
+        map_list.size() < 2     ||
+        map_list[1].type != Map_type::std)
+    {
+        return;
+    }
+
+    const int DLVL = map::dlvl +
+                     (map_list[1].is_main_dungeon == Is_main_dungeon::yes ? 1 : 0);
+
+    const unsigned long SEED = (unsigned long)rnd::range(1, INT_MAX);
+
+    TRACE << "Making layout of next level on worker thread" << endl;
+
+    nxt_lvl_layout_ = async(launch::async, mk_nxt_lvl_layout, DLVL, SEED);
+}
+
 void go_to_nxt()
 {
     TRACE_FUNC_BEGIN;
@@ -144,7 +281,9 @@ void go_to_nxt()
         ++map::dlvl;
     }
 
-    mk_lvl(map_data.type);
+    build_back_lvl(map_data.type);
+
+    map::enter_back_lvl();
 
     map::player->restore_shock(999, true);
 
@@ -20,8 +20,8 @@ namespace msg_log
 namespace
 {
 
-vector<Msg>           lines_[2];
-vector< vector<Msg> > history_;
+thread_local vector<Msg>           lines_[2];
+thread_local vector< vector<Msg> > history_;
 const string          more_str = "-More-";
 
 int x_after_msg(const Msg* const msg)
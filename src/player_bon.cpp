@@ -10,18 +10,19 @@
 #include "player_spells_handling.hpp"
 #include "map.hpp"
 #include "map_parsing.hpp"
+#include "utils.hpp"
 
 using namespace std;
 
 namespace player_bon
 {
 
-bool traits[int(Trait::END)];
+thread_local bool traits[int(Trait::END)];
 
 namespace
 {
 
-Bg bg_ = Bg::END;
+thread_local Bg bg_ = Bg::END;
 
 } //Namespace
 
@@ -644,7 +645,7 @@ void pickable_traits(vector<Trait>& traits_ref)
     }
 
     //Limit the number of trait choices (due to screen space constraints)
-    random_shuffle(traits_ref.begin(), traits_ref.end());
+    rnd::shuffle(traits_ref.begin(), traits_ref.end());
     const int MAX_NR_TRAIT_CHOICES = 16;
     traits_ref.resize(min(int(traits_ref.size()), MAX_NR_TRAIT_CHOICES));
 
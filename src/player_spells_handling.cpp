@@ -38,8 +38,8 @@ struct Spell_opt
     Item*   src_item;
 };
 
-vector<Spell*>  known_spells_;
-Spell_opt        prev_cast_;
+thread_local vector<Spell*>  known_spells_;
+thread_local Spell_opt        prev_cast_;
 
 void draw(Menu_browser& browser, const vector<Spell_opt>& spell_opts)
 {
@@ -20,13 +20,14 @@
 #include "feature_rigid.hpp"
 #include "feature_mob.hpp"
 #include "item.hpp"
+#include "game_time.hpp"
 
 using namespace std;
 
 namespace prop_data
 {
 
-Prop_data_t data[size_t(Prop_id::END)];
+thread_local Prop_data_t data[size_t(Prop_id::END)];
 
 namespace
 {
@@ -723,7 +724,20 @@ void init()
 
 } //Prop_data
 
+namespace
+{
+
+//Properties which change the speed of the actor (see Actor::speed)
+bool is_speed_prop(const Prop_id id)
+{
+    return id == Prop_id::slowed || id == Prop_id::hasted || id == Prop_id::frenzied;
+}
+
+} //namespace
+
 Prop_handler::Prop_handler(Actor* owning_actor) :
+    is_cache_dirty_(true),
+    cache_inv_revision_(-1),
     owning_actor_(owning_actor)
 {
     const Actor_data_t& d = owning_actor->data();
@@ -889,61 +903,45 @@ void Prop_handler::props_from_sources(
     }
 }
 
-void  Prop_handler::prop_ids_from_sources(
-    bool out[size_t(Prop_id::END)], bool sources[int(Prop_src::END)]) const
+const vector<Prop*>& Prop_handler::all_props() const
 {
-    for (int i = 0; i < int(Prop_id::END); ++i)
-    {
-        out[i] = 0;
-    }
+    const bool IS_INV_CHANGED = owning_actor_->is_humanoid() &&
+                                cache_inv_revision_ != Inventory::revision();
 
-    //Get from applied properties
-    if (sources[int(Prop_src::applied)])
+    if (is_cache_dirty_ || IS_INV_CHANGED)
     {
-        for (const Prop* const prop : applied_props_)
-        {
-            out[int(prop->id())] = true;
-        }
-    }
+        bool sources[int(Prop_src::END)];
 
-    //Get from inventory if humanoid actor
-    if (owning_actor_->is_humanoid() && sources[int(Prop_src::inv)])
-    {
-        const auto& inv = owning_actor_->inv();
+        for (bool& v : sources) {v = true;}
 
-        auto add_item_props = [&](const vector<Prop*>& item_prop_list)
-        {
-            for (auto* const prop : item_prop_list)
-            {
-                prop->owning_actor_      = owning_actor_;
-                out[int(prop->id())] = true;
-            };
-        };
+        props_from_sources(all_props_cache_, sources);
 
-        for (const auto& slot : inv.slots_)
-        {
-            const auto* const item = slot.item;
+        for (bool& v : prop_ids_cache_) {v = false;}
 
-            if (item)
-            {
-                add_item_props(item->carrier_props_);
-            }
-        }
-
-        for (auto* const item : inv.general_)
+        for (const Prop* const prop : all_props_cache_)
         {
-            add_item_props(item->carrier_props_);
+            prop_ids_cache_[size_t(prop->id())] = true;
         }
+
+        is_cache_dirty_     = false;
+        cache_inv_revision_ = Inventory::revision();
     }
+
+    return all_props_cache_;
 }
 
 void Prop_handler::prop_ids(bool out[size_t(Prop_id::END)]) const
 {
-    bool sources[int(Prop_src::END)];
+    all_props();
+
+    for (size_t i = 0; i < size_t(Prop_id::END); ++i) {out[i] = prop_ids_cache_[i];}
+}
 
-    for (bool& v : sources) {v = true;}
+bool Prop_handler::has_prop(const Prop_id id) const
+{
+    all_props();
 
-    prop_ids_from_sources(out, sources);
+    return prop_ids_cache_[size_t(id)];
 }
 
 bool Prop_handler::try_resist_prop(const Prop_id id, const vector<Prop*>& prop_list) const
@@ -961,12 +959,7 @@ bool Prop_handler::try_resist_prop(const Prop_id id, const vector<Prop*>& prop_l
 
 bool Prop_handler::try_resist_dmg(const Dmg_type dmg_type, const bool ALLOW_MSG) const
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* p : prop_list)
     {
@@ -978,12 +971,7 @@ bool Prop_handler::try_resist_dmg(const Dmg_type dmg_type, const bool ALLOW_MSG)
 
 bool Prop_handler::allow_see() const
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* p : prop_list) {if (!p->allow_see()) return false;}
 
@@ -1022,15 +1010,7 @@ void Prop_handler::try_apply_prop(Prop* const prop, const bool FORCE_EFFECT,
 
     if (!FORCE_EFFECT)
     {
-        vector<Prop*> all_props;
-
-        bool sources[int(Prop_src::END)];
-
-        for (bool& v : sources) {v = true;}
-
-        props_from_sources(all_props, sources);
-
-        if (try_resist_prop(prop->id(), all_props))
+        if (try_resist_prop(prop->id(), all_props()))
         {
             if (!NO_MESSAGES)
             {
@@ -1118,8 +1098,12 @@ void Prop_handler::try_apply_prop(Prop* const prop, const bool FORCE_EFFECT,
     //This part reached means the property is new
     applied_props_.push_back(prop);
 
+    is_cache_dirty_ = true;
+
     if (!DISABLE_PROP_START_EFFECTS) {prop->on_start();}
 
+    if (is_speed_prop(prop->id())) {game_time::on_actor_speed_changed(*owning_actor_);}
+
     if (!DISABLE_REDRAW)
     {
         if (prop->should_update_player_visual_when_start_or_end())
@@ -1205,6 +1189,10 @@ bool Prop_handler::end_applied_prop(const Prop_id id, const bool RUN_PROP_END_EF
 
     applied_props_.erase(begin(applied_props_) + idx);
 
+    is_cache_dirty_ = true;
+
+    if (is_speed_prop(id)) {game_time::on_actor_speed_changed(*owning_actor_);}
+
     if (RUN_PROP_END_EFFECTS)
     {
         const bool IS_VISUAL_UPDATE_NEEDED =
@@ -1328,12 +1316,7 @@ void Prop_handler::props_interface_line(vector<Str_and_clr>& line) const
 
     const bool IS_SELF_AWARE = player_bon::traits[int(Trait::self_aware)];
 
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1356,12 +1339,7 @@ void Prop_handler::props_interface_line(vector<Str_and_clr>& line) const
 
 int Prop_handler::changed_max_hp(const int HP_MAX) const
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
     int new_hp_max = HP_MAX;
 
     for (Prop* prop : prop_list) {new_hp_max = prop->changed_max_hp(new_hp_max);}
@@ -1371,24 +1349,14 @@ int Prop_handler::changed_max_hp(const int HP_MAX) const
 
 void Prop_handler::change_move_dir(const Pos& actor_pos, Dir& dir) const
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    vector<Prop*> prop_list = all_props();
 
     for (Prop* prop : prop_list) {prop->change_move_dir(actor_pos, dir);}
 }
 
 bool Prop_handler::allow_attack(const bool ALLOW_MSG) const
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1403,12 +1371,7 @@ bool Prop_handler::allow_attack(const bool ALLOW_MSG) const
 
 bool Prop_handler::allow_attack_melee(const bool ALLOW_MSG) const
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1423,13 +1386,7 @@ bool Prop_handler::allow_attack_melee(const bool ALLOW_MSG) const
 
 bool Prop_handler::allow_attack_ranged(const bool ALLOW_MSG) const
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1441,13 +1398,7 @@ bool Prop_handler::allow_attack_ranged(const bool ALLOW_MSG) const
 
 bool Prop_handler::allow_move() const
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1459,13 +1410,7 @@ bool Prop_handler::allow_move() const
 
 bool Prop_handler::allow_act() const
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1478,13 +1423,7 @@ bool Prop_handler::allow_act() const
 bool Prop_handler::allow_read(const bool ALLOW_MSG) const
 {
     TRACE_FUNC_BEGIN_VERBOSE;
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (auto prop : prop_list)
     {
@@ -1501,13 +1440,7 @@ bool Prop_handler::allow_read(const bool ALLOW_MSG) const
 
 bool Prop_handler::allow_cast_spell(const bool ALLOW_MSG) const
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (auto prop : prop_list)
     {
@@ -1523,13 +1456,7 @@ bool Prop_handler::allow_cast_spell(const bool ALLOW_MSG) const
 bool Prop_handler::allow_speak(const bool ALLOW_MSG) const
 {
     TRACE_FUNC_BEGIN_VERBOSE;
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (auto prop : prop_list)
     {
@@ -1547,13 +1474,7 @@ bool Prop_handler::allow_speak(const bool ALLOW_MSG) const
 bool Prop_handler::allow_eat(const bool ALLOW_MSG) const
 {
     TRACE_FUNC_BEGIN_VERBOSE;
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (auto prop : prop_list)
     {
@@ -1570,13 +1491,7 @@ bool Prop_handler::allow_eat(const bool ALLOW_MSG) const
 
 void Prop_handler::on_hit()
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    vector<Prop*> prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1586,13 +1501,7 @@ void Prop_handler::on_hit()
 
 void Prop_handler::on_death(const bool IS_PLAYER_SEE_OWNING_ACTOR)
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    vector<Prop*> prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1602,13 +1511,7 @@ void Prop_handler::on_death(const bool IS_PLAYER_SEE_OWNING_ACTOR)
 
 int Prop_handler::ability_mod(const Ability_id ability) const
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     int modifier = 0;
 
@@ -1655,13 +1558,7 @@ Prop* Prop_handler::prop(const Prop_id id, const Prop_src source) const
 
 bool Prop_handler::change_actor_clr(Clr& clr) const
 {
-    vector<Prop*> prop_list;
-
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    const vector<Prop*>& prop_list = all_props();
 
     for (Prop* prop : prop_list)
     {
@@ -1676,12 +1573,7 @@ bool Prop_handler::change_actor_clr(Clr& clr) const
 
 void Prop_handler::end_applied_props_by_magic_healing()
 {
-    vector<Prop*> prop_list;
-    bool sources[int(Prop_src::END)];
-
-    for (bool& v : sources) {v = true;}
-
-    props_from_sources(prop_list, sources);
+    vector<Prop*> prop_list = all_props();
 
     for (size_t i = 0; i < prop_list.size(); ++i)
     {
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <iostream>
+#include <fstream>
 
 #include "init.hpp"
 #include "item.hpp"
@@ -26,8 +27,8 @@ using namespace std;
 namespace render
 {
 
-Cell_render_data render_array[MAP_W][MAP_H];
-Cell_render_data render_array_no_actors[MAP_W][MAP_H];
+thread_local Cell_render_data render_array[MAP_W][MAP_H];
+thread_local Cell_render_data render_array_no_actors[MAP_W][MAP_H];
 
 namespace
 {
@@ -47,86 +48,135 @@ bool tile_px_data_[PIXEL_DATA_W][PIXEL_DATA_H];
 bool font_px_data_[PIXEL_DATA_W][PIXEL_DATA_H];
 bool contour_px_data_[PIXEL_DATA_W][PIXEL_DATA_H];
 
+//A horizontal run of set pixels in a sprite sheet cell (relative to the cell)
+struct Px_span
+{
+    int x0, y, len;
+};
+
+//The pixel data above, pre-rasterized into row-major spans for each sheet cell (indexed
+//by sheet position), so that each row of a glyph or tile is drawn with one fill
+vector< vector<Px_span> > tile_spans_;
+vector< vector<Px_span> > font_spans_;
+vector< vector<Px_span> > contour_spans_;
+
+int sheet_w_in_cells_ = 0;
+
+//The map is only redrawn where it has changed. For each cell, drawn_map_ holds what
+//draw_map last drew there, and is_drawn_map_cell_valid_ is cleared when anything else
+//is drawn over the cell (popups, markers, blasts, etc).
+Cell_render_data    drawn_map_[MAP_W][MAP_H];
+bool                is_drawn_map_cell_valid_[MAP_W][MAP_H];
+bool                is_drawing_map_ = false;
+
+//Pixel rows of the screen surface which have changed since the last update
+vector<bool>        is_px_row_dirty_;
+
+//NOTE: With the "none" render backend, nothing is initialized (and nothing is drawn)
 bool is_inited()
 {
-    return sdl_window_;
+    return scr_srf_;
 }
 
-Uint32 px(SDL_Surface& srf, const int PIXEL_X, const int PIXEL_Y)
+void invalidate_drawn_map()
 {
-    const int BPP = srf.format->BytesPerPixel;
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            is_drawn_map_cell_valid_[x][y] = false;
+        }
+    }
+}
 
-    //p is the address to the pixel we want to retrieve
-    Uint8* p = (Uint8*)srf.pixels + PIXEL_Y * srf.pitch + PIXEL_X * BPP;
+//Call for each area drawn on the screen surface
+void on_px_area_drawn(const Pos& px_pos, const Pos& px_dims)
+{
+    const int PX_Y0 = max(0, px_pos.y);
+    const int PX_Y1 = min(int(is_px_row_dirty_.size()), px_pos.y + px_dims.y) - 1;
 
-    switch (BPP)
+    for (int px_y = PX_Y0; px_y <= PX_Y1; ++px_y)
     {
-    case 1:
-        return *p;
+        is_px_row_dirty_[px_y] = true;
+    }
 
-    case 2:
-        return *(Uint16*)p;
+    if (is_drawing_map_ || px_dims.x <= 0 || PX_Y0 > PX_Y1)
+    {
+        return;
+    }
 
-    case 3:
-        if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
-        {
-            return p[0] << 16 | p[1] << 8 | p[2];
-        }
-        else
-        {
-            return p[0] | p[1] << 8 | p[2] << 16;
-        }
-        break;
+    //Something other than draw_map has drawn here, mark any covered map cells for redraw
+    const int CELL_W        = config::cell_px_w();
+    const int CELL_H        = config::cell_px_h();
+    const int MAP_PX_Y0     = config::map_px_offset_h();
+    const int MAP_PX_Y1     = MAP_PX_Y0 + config::map_px_h() - 1;
+    const int MAP_PX_X1     = (MAP_W * CELL_W) - 1;
+    const int PX_X0         = max(0, px_pos.x);
+    const int PX_X1         = min(MAP_PX_X1, px_pos.x + px_dims.x - 1);
 
-    case 4:
-        return *(Uint32*)p;
+    if (PX_X0 > PX_X1 || PX_Y1 < MAP_PX_Y0 || PX_Y0 > MAP_PX_Y1)
+    {
+        return;
+    }
 
-    default:
-        break;
+    const int X0 = PX_X0 / CELL_W;
+    const int X1 = PX_X1 / CELL_W;
+    const int Y0 = (max(PX_Y0, MAP_PX_Y0) - MAP_PX_Y0) / CELL_H;
+    const int Y1 = (min(PX_Y1, MAP_PX_Y1) - MAP_PX_Y0) / CELL_H;
+
+    for (int x = X0; x <= X1; ++x)
+    {
+        for (int y = Y0; y <= Y1; ++y)
+        {
+            is_drawn_map_cell_valid_[x][y] = false;
+        }
     }
+}
 
-    return -1;
+bool is_drawn_the_same(const Cell_render_data& d1, const Cell_render_data& d2)
+{
+    return d1.tile                  == d2.tile                  &&
+           d1.glyph                 == d2.glyph                 &&
+           d1.lifebar_length        == d2.lifebar_length        &&
+           d1.is_aware_of_mon_here  == d2.is_aware_of_mon_here  &&
+           utils::is_clr_eq(d1.clr,    d2.clr)                 &&
+           utils::is_clr_eq(d1.clr_bg, d2.clr_bg);
 }
 
-void put_px(const SDL_Surface& srf, const int PIXEL_X, const int PIXEL_Y, Uint32 px)
+Uint32 px(SDL_Surface& srf, const int PIXEL_X, const int PIXEL_Y)
 {
     const int BPP = srf.format->BytesPerPixel;
 
-    //p is the address to the pixel we want to set
-    Uint8* const p = (Uint8*)srf.pixels + PIXEL_Y * srf.pitch + PIXEL_X * BPP;
+    //p is the address to the pixel we want to retrieve
+    Uint8* p = (Uint8*)srf.pixels + PIXEL_Y * srf.pitch + PIXEL_X * BPP;
 
     switch (BPP)
     {
     case 1:
-        *p = px;
-        break;
+        return *p;
 
     case 2:
-        *(Uint16*)p = px;
-        break;
+        return *(Uint16*)p;
 
     case 3:
         if (SDL_BYTEORDER == SDL_BIG_ENDIAN)
         {
-            p[0] = (px >> 16) & 0xff;
-            p[1] = (px >> 8)  & 0xff;
-            p[2] = px & 0xff;
+            return p[0] << 16 | p[1] << 8 | p[2];
         }
-        else //Little endian
+        else
         {
-            p[0] = px & 0xff;
-            p[1] = (px >> 8)  & 0xff;
-            p[2] = (px >> 16) & 0xff;
+            return p[0] | p[1] << 8 | p[2] << 16;
         }
         break;
 
     case 4:
-        *(Uint32*)p = px;
-        break;
+        return *(Uint32*)p;
 
     default:
         break;
     }
+
+    return -1;
 }
 
 void blit_surface(SDL_Surface& srf, const Pos& px_pos)
@@ -137,6 +187,8 @@ void blit_surface(SDL_Surface& srf, const Pos& px_pos)
     };
 
     SDL_BlitSurface(&srf, nullptr, scr_srf_, &dst_rect);
+
+    on_px_area_drawn(px_pos, Pos(srf.w, srf.h));
 }
 
 void load_main_menu_logo()
@@ -246,49 +298,102 @@ void load_contour(const bool base[PIXEL_DATA_W][PIXEL_DATA_H])
     }
 }
 
-void put_pixels_on_scr(const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
+void mk_sheet_spans(const bool px_data[PIXEL_DATA_W][PIXEL_DATA_H],
+                    vector< vector<Px_span> >& sheet_spans)
+{
+    const int CELL_W        = config::cell_px_w();
+    const int CELL_H        = config::cell_px_h();
+    const int SHEET_W_CELLS = PIXEL_DATA_W / CELL_W;
+    const int SHEET_H_CELLS = PIXEL_DATA_H / CELL_H;
+
+    sheet_w_in_cells_ = SHEET_W_CELLS;
+
+    sheet_spans.clear();
+    sheet_spans.resize(SHEET_W_CELLS * SHEET_H_CELLS);
+
+    for (int sheet_y = 0; sheet_y < SHEET_H_CELLS; ++sheet_y)
+    {
+        for (int sheet_x = 0; sheet_x < SHEET_W_CELLS; ++sheet_x)
+        {
+            vector<Px_span>& spans  = sheet_spans[(sheet_y * SHEET_W_CELLS) + sheet_x];
+            const int SHEET_PX_X0   = sheet_x * CELL_W;
+            const int SHEET_PX_Y0   = sheet_y * CELL_H;
+
+            for (int y = 0; y < CELL_H; ++y)
+            {
+                int x = 0;
+
+                while (x < CELL_W)
+                {
+                    if (px_data[SHEET_PX_X0 + x][SHEET_PX_Y0 + y])
+                    {
+                        const int SPAN_X0 = x;
+
+                        while (x < CELL_W && px_data[SHEET_PX_X0 + x][SHEET_PX_Y0 + y])
+                        {
+                            ++x;
+                        }
+
+                        spans.push_back({SPAN_X0, y, x - SPAN_X0});
+                    }
+                    else
+                    {
+                        ++x;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void put_pixels_on_scr(const vector< vector<Px_span> >& sheet_spans,
                        const Pos& sheet_pos, const Pos& scr_px_pos, const Clr& clr)
 {
     if (is_inited())
     {
-        const int PX_CLR = SDL_MapRGB(scr_srf_->format, clr.r, clr.g, clr.b);
+        const Uint32 PX_CLR = SDL_MapRGB(scr_srf_->format, clr.r, clr.g, clr.b);
+
+        on_px_area_drawn(scr_px_pos, Pos(config::cell_px_w(), config::cell_px_h()));
 
-        const int CELL_W      = config::cell_px_w();
-        const int CELL_H      = config::cell_px_h();
-        const int SHEET_PX_X0 = sheet_pos.x * CELL_W;
-        const int SHEET_PX_Y0 = sheet_pos.y * CELL_H;
-        const int SHEET_PX_X1 = SHEET_PX_X0 + CELL_W - 1;
-        const int SHEET_PX_Y1 = SHEET_PX_Y0 + CELL_H - 1;
-        const int SCR_PX_X0   = scr_px_pos.x;
-        const int SCR_PX_Y0   = scr_px_pos.y;
+        const size_t SHEET_IDX = (sheet_pos.y * sheet_w_in_cells_) + sheet_pos.x;
 
-        int scr_px_x = SCR_PX_X0;
+        assert(SHEET_IDX < sheet_spans.size());
 
-        for (int sheet_px_x = SHEET_PX_X0; sheet_px_x <= SHEET_PX_X1; sheet_px_x++)
+        //NOTE: The screen surface is always 32 bits per pixel (see init)
+        Uint8* const    scr_pixels  = (Uint8*)scr_srf_->pixels;
+        const int       SCR_PX_W    = scr_srf_->w;
+        const int       SCR_PX_H    = scr_srf_->h;
+
+        for (const Px_span& span : sheet_spans[SHEET_IDX])
         {
-            int scr_px_y = SCR_PX_Y0;
+            const int SCR_PX_Y = scr_px_pos.y + span.y;
 
-            for (int sheet_px_y = SHEET_PX_Y0; sheet_px_y <= SHEET_PX_Y1; sheet_px_y++)
+            if (SCR_PX_Y < 0 || SCR_PX_Y >= SCR_PX_H)
             {
-                if (px_data[sheet_px_x][sheet_px_y])
-                {
-                    put_px(*scr_srf_, scr_px_x, scr_px_y, PX_CLR);
-                }
-                ++scr_px_y;
+                continue;
+            }
+
+            const int SCR_PX_X0 = max(0,        scr_px_pos.x + span.x0);
+            const int SCR_PX_X1 = min(SCR_PX_W, scr_px_pos.x + span.x0 + span.len);
+
+            Uint32* const scr_row = (Uint32*)(scr_pixels + (SCR_PX_Y * scr_srf_->pitch));
+
+            for (int scr_px_x = SCR_PX_X0; scr_px_x < SCR_PX_X1; ++scr_px_x)
+            {
+                scr_row[scr_px_x] = PX_CLR;
             }
-            ++scr_px_x;
         }
     }
 }
 
 void put_pixels_on_scr_for_tile(const Tile_id tile, const Pos& scr_px_pos, const Clr& clr)
 {
-    put_pixels_on_scr(tile_px_data_, art::tile_pos(tile), scr_px_pos, clr);
+    put_pixels_on_scr(tile_spans_, art::tile_pos(tile), scr_px_pos, clr);
 }
 
 void put_pixels_on_scr_for_glyph(const char GLYPH, const Pos& scr_px_pos, const Clr& clr)
 {
-    put_pixels_on_scr(font_px_data_, art::glyph_pos(GLYPH), scr_px_pos, clr);
+    put_pixels_on_scr(font_spans_, art::glyph_pos(GLYPH), scr_px_pos, clr);
 }
 
 Pos px_pos_for_cell_in_panel(const Panel panel, const Pos& pos)
@@ -387,7 +492,7 @@ void draw_glyph_at_px(const char GLYPH, const Pos& px_pos, const Clr& clr,
         //Only draw contour if neither the foreground or background is black
         if (!utils::is_clr_eq(clr, clr_black) && !utils::is_clr_eq(bg_clr, clr_black))
         {
-            put_pixels_on_scr(contour_px_data_, art::glyph_pos(GLYPH), px_pos, clr_black);
+            put_pixels_on_scr(contour_spans_, art::glyph_pos(GLYPH), px_pos, clr_black);
         }
     }
 
@@ -401,43 +506,55 @@ void init()
     TRACE_FUNC_BEGIN;
     cleanup();
 
-    TRACE << "Setting up rendering window" << endl;
+    const Render_backend backend = config::render_backend();
 
-    const string title = "IA " + game_version_str;
+    if (backend == Render_backend::none)
+    {
+        TRACE << "No rendering" << endl;
+        TRACE_FUNC_END;
+        return;
+    }
 
     const int SCR_PX_W = config::scr_px_w();
     const int SCR_PX_H = config::scr_px_h();
 
-    if (config::is_fullscreen())
+    if (backend == Render_backend::sdl)
     {
-        sdl_window_ = SDL_CreateWindow(title.c_str(),
-                                       SDL_WINDOWPOS_UNDEFINED,
-                                       SDL_WINDOWPOS_UNDEFINED,
-                                       SCR_PX_W, SCR_PX_H,
-                                       SDL_WINDOW_FULLSCREEN_DESKTOP);
-    }
+        TRACE << "Setting up rendering window" << endl;
 
-    if (!config::is_fullscreen() || !sdl_window_)
-    {
-        sdl_window_ = SDL_CreateWindow(title.c_str(),
-                                       SDL_WINDOWPOS_UNDEFINED,
-                                       SDL_WINDOWPOS_UNDEFINED,
-                                       SCR_PX_W, SCR_PX_H,
-                                       SDL_WINDOW_SHOWN);
-    }
+        const string title = "IA " + game_version_str;
 
-    if (!sdl_window_)
-    {
-        TRACE << "Failed to create window" << endl;
-        assert(false);
-    }
+        if (config::is_fullscreen())
+        {
+            sdl_window_ = SDL_CreateWindow(title.c_str(),
+                                           SDL_WINDOWPOS_UNDEFINED,
+                                           SDL_WINDOWPOS_UNDEFINED,
+                                           SCR_PX_W, SCR_PX_H,
+                                           SDL_WINDOW_FULLSCREEN_DESKTOP);
+        }
 
-    sdl_renderer_ = SDL_CreateRenderer(sdl_window_, -1, SDL_RENDERER_ACCELERATED);
+        if (!config::is_fullscreen() || !sdl_window_)
+        {
+            sdl_window_ = SDL_CreateWindow(title.c_str(),
+                                           SDL_WINDOWPOS_UNDEFINED,
+                                           SDL_WINDOWPOS_UNDEFINED,
+                                           SCR_PX_W, SCR_PX_H,
+                                           SDL_WINDOW_SHOWN);
+        }
 
-    if (!sdl_renderer_)
-    {
-        TRACE << "Failed to create SDL renderer" << endl;
-        assert(false);
+        if (!sdl_window_)
+        {
+            TRACE << "Failed to create window" << endl;
+            assert(false);
+        }
+
+        sdl_renderer_ = SDL_CreateRenderer(sdl_window_, -1, SDL_RENDERER_ACCELERATED);
+
+        if (!sdl_renderer_)
+        {
+            TRACE << "Failed to create SDL renderer" << endl;
+            assert(false);
+        }
     }
 
     scr_srf_ = SDL_CreateRGBSurface(0,
@@ -454,15 +571,18 @@ void init()
         assert(false);
     }
 
-    scr_texture_ = SDL_CreateTexture(sdl_renderer_,
-                                     SDL_PIXELFORMAT_ARGB8888,
-                                     SDL_TEXTUREACCESS_STREAMING,
-                                     SCR_PX_W, SCR_PX_H);
-
-    if (!scr_texture_)
+    if (backend == Render_backend::sdl)
     {
-        TRACE << "Failed to create screen texture" << endl;
-        assert(false);
+        scr_texture_ = SDL_CreateTexture(sdl_renderer_,
+                                         SDL_PIXELFORMAT_ARGB8888,
+                                         SDL_TEXTUREACCESS_STREAMING,
+                                         SCR_PX_W, SCR_PX_H);
+
+        if (!scr_texture_)
+        {
+            TRACE << "Failed to create screen texture" << endl;
+            assert(false);
+        }
     }
 
     load_font();
@@ -475,6 +595,16 @@ void init()
 
     load_contour(config::is_tiles_mode() ? tile_px_data_ : font_px_data_);
 
+    assert(scr_srf_->format->BytesPerPixel == 4);
+
+    mk_sheet_spans(tile_px_data_,      tile_spans_);
+    mk_sheet_spans(font_px_data_,      font_spans_);
+    mk_sheet_spans(contour_px_data_,   contour_spans_);
+
+    invalidate_drawn_map();
+
+    is_px_row_dirty_.assign(SCR_PX_H, true);
+
     TRACE_FUNC_END;
 }
 
@@ -517,6 +647,11 @@ void cleanup()
 
 void on_toggle_fullscreen()
 {
+    if (!sdl_window_)
+    {
+        return;
+    }
+
     if (config::is_fullscreen())
     {
         SDL_SetWindowFullscreen(sdl_window_, SDL_WINDOW_FULLSCREEN_DESKTOP);
@@ -531,12 +666,74 @@ void on_toggle_fullscreen()
 
 void update_screen()
 {
-    if (is_inited())
+    if (!is_inited())
+    {
+        return;
+    }
+
+    //Only the "sdl" render backend presents anything
+    if (sdl_renderer_)
     {
-        SDL_UpdateTexture(scr_texture_, nullptr, scr_srf_->pixels, scr_srf_->pitch);
+        //Only upload the pixel rows which have changed since the last update
+        const int SCR_PX_H = is_px_row_dirty_.size();
+
+        int dirty_px_y0 = -1;
+
+        for (int px_y = 0; px_y <= SCR_PX_H; ++px_y)
+        {
+            const bool IS_DIRTY = px_y < SCR_PX_H && is_px_row_dirty_[px_y];
+
+            if (IS_DIRTY && dirty_px_y0 < 0)
+            {
+                dirty_px_y0 = px_y;
+            }
+            else if (!IS_DIRTY && dirty_px_y0 >= 0)
+            {
+                const SDL_Rect dirty_rect = {0, dirty_px_y0, scr_srf_->w, px_y - dirty_px_y0};
+
+                const Uint8* const pixels =
+                    (const Uint8*)scr_srf_->pixels + (dirty_px_y0 * scr_srf_->pitch);
+
+                SDL_UpdateTexture(scr_texture_, &dirty_rect, pixels, scr_srf_->pitch);
+
+                dirty_px_y0 = -1;
+            }
+        }
+
         SDL_RenderCopy(sdl_renderer_, scr_texture_, nullptr, nullptr);
         SDL_RenderPresent(sdl_renderer_);
     }
+
+    is_px_row_dirty_.assign(is_px_row_dirty_.size(), false);
+}
+
+bool save_ppm(const string& file_path)
+{
+    assert(is_inited() && "Nothing is drawn with this render backend");
+
+    ofstream file(file_path.c_str(), ios::binary | ios::trunc);
+
+    if (!file.is_open())
+    {
+        TRACE << "Failed to open " << file_path << endl;
+        return false;
+    }
+
+    file << "P6" << endl << scr_srf_->w << " " << scr_srf_->h << endl << 255 << endl;
+
+    for (int y = 0; y < scr_srf_->h; ++y)
+    {
+        for (int x = 0; x < scr_srf_->w; ++x)
+        {
+            Uint8 rgb[3];
+
+            SDL_GetRGB(px(*scr_srf_, x, y), scr_srf_->format, &rgb[0], &rgb[1], &rgb[2]);
+
+            file.write((const char*)rgb, 3);
+        }
+    }
+
+    return file.good();
 }
 
 void clear_screen()
@@ -544,11 +741,18 @@ void clear_screen()
     if (is_inited())
     {
         SDL_FillRect(scr_srf_, nullptr, SDL_MapRGB(scr_srf_->format, 0, 0, 0));
+
+        on_px_area_drawn(Pos(0, 0), Pos(scr_srf_->w, scr_srf_->h));
     }
 }
 
 void draw_main_menu_logo(const int Y_POS)
 {
+    if (!main_menu_logo_srf_)
+    {
+        return;
+    }
+
     const int SCR_PX_W  = config::scr_px_w();
     const int LOGO_PX_H = main_menu_logo_srf_->w;
     const int CELL_PX_H = config::cell_px_h();
@@ -796,7 +1000,7 @@ void draw_tile(const Tile_id tile, const Panel panel, const Pos& pos, const Clr&
 
         if (!utils::is_clr_eq(bg_clr, clr_black))
         {
-            put_pixels_on_scr(contour_px_data_, art::tile_pos(tile), px_pos, clr_black);
+            put_pixels_on_scr(contour_spans_, art::tile_pos(tile), px_pos, clr_black);
         }
 
         put_pixels_on_scr_for_tile(tile, px_pos, clr);
@@ -883,14 +1087,7 @@ int draw_text_centered(const string& str, const Panel panel, const Pos& pos,
 
     const int W_TOT_PIXEL = LEN * cell_dims.x;
 
-    SDL_Rect sdl_rect =
-    {
-        (Sint16)px_pos.x, (Sint16)px_pos.y,
-        (Uint16)W_TOT_PIXEL, (Uint16)cell_dims.y
-    };
-
-    SDL_FillRect(scr_srf_, &sdl_rect,
-                 SDL_MapRGB(scr_srf_->format, bg_clr.r, bg_clr.g, bg_clr.b));
+    draw_rectangle_solid(px_pos, Pos(W_TOT_PIXEL, cell_dims.y), bg_clr);
 
     for (int i = 0; i < LEN; ++i)
     {
@@ -978,6 +1175,8 @@ void draw_rectangle_solid(const Pos& px_pos, const Pos& px_dims, const Clr& clr)
         };
 
         SDL_FillRect(scr_srf_, &sdl_rect, SDL_MapRGB(scr_srf_->format, clr.r, clr.g, clr.b));
+
+        on_px_area_drawn(px_pos, px_dims);
     }
 }
 
@@ -1109,7 +1308,8 @@ void draw_map_and_interface(const bool SHOULD_UPDATE_SCREEN)
 {
     if (is_inited())
     {
-        clear_screen();
+        //NOTE: The map is not covered here, draw_map redraws the cells that have changed
+        cover_panel(Panel::log);
 
         draw_map();
 
@@ -1128,6 +1328,8 @@ void draw_map()
 {
     if (!is_inited()) {return;}
 
+    is_drawing_map_ = true;
+
     Cell_render_data* cur_drw = nullptr;
     Cell_render_data  tmp_drw;
 
@@ -1447,26 +1649,41 @@ void draw_map()
 
             Pos pos(x, y);
 
-            if (tmp_drw.is_aware_of_mon_here)
+            //Only draw the cell if it should look different from last time it was drawn,
+            //or if something else has been drawn over it since then
+            if (
+                !is_drawn_map_cell_valid_[x][y] ||
+                !is_drawn_the_same(tmp_drw, drawn_map_[x][y]))
             {
-                draw_glyph('!', Panel::map, pos, clr_black, true, clr_nosf_teal_drk);
-            }
-            else if (tmp_drw.tile != Tile_id::empty && tmp_drw.glyph != ' ')
-            {
-                if (IS_TILES)
+                if (tmp_drw.is_aware_of_mon_here)
                 {
-                    draw_tile(tmp_drw.tile, Panel::map, pos, tmp_drw.clr, tmp_drw.clr_bg);
+                    draw_glyph('!', Panel::map, pos, clr_black, true, clr_nosf_teal_drk);
                 }
-                else
+                else if (tmp_drw.tile != Tile_id::empty && tmp_drw.glyph != ' ')
                 {
-                    draw_glyph(tmp_drw.glyph, Panel::map, pos, tmp_drw.clr, true,
-                               tmp_drw.clr_bg);
-                }
+                    if (IS_TILES)
+                    {
+                        draw_tile(tmp_drw.tile, Panel::map, pos, tmp_drw.clr,
+                                  tmp_drw.clr_bg);
+                    }
+                    else
+                    {
+                        draw_glyph(tmp_drw.glyph, Panel::map, pos, tmp_drw.clr, true,
+                                   tmp_drw.clr_bg);
+                    }
 
-                if (tmp_drw.lifebar_length != -1)
+                    if (tmp_drw.lifebar_length != -1)
+                    {
+                        draw_life_bar(pos, tmp_drw.lifebar_length);
+                    }
+                }
+                else //Nothing to draw here
                 {
-                    draw_life_bar(pos, tmp_drw.lifebar_length);
+                    cover_cell_in_map(pos);
                 }
+
+                drawn_map_[x][y]                = tmp_drw;
+                is_drawn_map_cell_valid_[x][y]  = true;
             }
 
             if (!cell.is_explored) {render_array[x][y] = Cell_render_data();}
@@ -1501,6 +1718,11 @@ void draw_map()
     }
 
     draw_player_shock_excl_marks();
+
+    //The player is drawn on top of the map cell, so this cell must be redrawn next time
+    is_drawn_map_cell_valid_[pos.x][pos.y] = false;
+
+    is_drawing_map_ = false;
 }
 
 } //render
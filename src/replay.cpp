@@ -0,0 +1,157 @@
+#include "replay.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <assert.h>
+
+#include "init.hpp"
+#include "input.hpp"
+
+using namespace std;
+
+namespace replay
+{
+
+namespace
+{
+
+//File layout (all integers little endian):
+//  Header: MAGIC, VERSION (1 byte), seed (8 bytes)
+//  Keys:   key (1 byte), SDL key code (4 bytes), modifier flags (1 byte)
+const char      MAGIC[]         = "IA_REPLAY";
+const size_t    MAGIC_SIZE      = sizeof(MAGIC) - 1;
+const char      VERSION         = 1;
+const size_t    KEY_REC_SIZE    = 6;
+
+const char      SHIFT_FLAG      = 1 << 0;
+const char      CTRL_FLAG       = 1 << 1;
+
+ofstream    rec_file_;
+ifstream    play_file_;
+
+void put_uint(char* const dst, const unsigned long long VAL, const size_t NR_BYTES)
+{
+    for (size_t i = 0; i < NR_BYTES; ++i)
+    {
+        dst[i] = char((VAL >> (i * 8)) & 0xFF);
+    }
+}
+
+unsigned long long get_uint(const char* const src, const size_t NR_BYTES)
+{
+    unsigned long long val = 0;
+
+    for (size_t i = 0; i < NR_BYTES; ++i)
+    {
+        val |= (unsigned long long)(unsigned char)src[i] << (i * 8);
+    }
+
+    return val;
+}
+
+} //namespace
+
+bool start_recording(const string& path, const unsigned long SEED)
+{
+    assert(!rec_file_.is_open());
+
+    rec_file_.open(path, ios::binary | ios::trunc);
+
+    if (!rec_file_.is_open())
+    {
+        TRACE << "Could not open replay file for writing: " << path << endl;
+        return false;
+    }
+
+    char header[MAGIC_SIZE + 1 + 8];
+
+    memcpy(header, MAGIC, MAGIC_SIZE);
+    header[MAGIC_SIZE] = VERSION;
+    put_uint(header + MAGIC_SIZE + 1, SEED, 8);
+
+    rec_file_.write(header, sizeof(header));
+    rec_file_.flush();
+
+    TRACE << "Recording replay to " << path << " (seed " << SEED << ")" << endl;
+
+    return true;
+}
+
+bool start_playback(const string& path, unsigned long& seed_ref)
+{
+    assert(!play_file_.is_open());
+
+    play_file_.open(path, ios::binary);
+
+    char header[MAGIC_SIZE + 1 + 8];
+
+    if (
+        !play_file_.is_open()                                           ||
+        !play_file_.read(header, sizeof(header))                        ||
+        memcmp(header, MAGIC, MAGIC_SIZE) != 0                          ||
+        header[MAGIC_SIZE] != VERSION)
+    {
+        TRACE << "Not a valid replay file: " << path << endl;
+        play_file_.close();
+        return false;
+    }
+
+    seed_ref = (unsigned long)get_uint(header + MAGIC_SIZE + 1, 8);
+
+    TRACE << "Playing replay from " << path << " (seed " << seed_ref << ")" << endl;
+
+    return true;
+}
+
+void cleanup()
+{
+    rec_file_.close();
+    play_file_.close();
+}
+
+bool is_playing()
+{
+    return play_file_.is_open();
+}
+
+bool next_key(Key_data& d)
+{
+    assert(is_playing());
+
+    char rec[KEY_REC_SIZE];
+
+    if (!play_file_.read(rec, KEY_REC_SIZE))
+    {
+        TRACE << "Replay ended" << endl;
+        play_file_.close();
+        return false;
+    }
+
+    d = Key_data(rec[0],
+                 SDL_Keycode(Sint32(get_uint(rec + 1, 4))),
+                 rec[5] & SHIFT_FLAG,
+                 rec[5] & CTRL_FLAG);
+
+    return true;
+}
+
+void on_key_read(const Key_data& d)
+{
+    if (!rec_file_.is_open())
+    {
+        return;
+    }
+
+    char rec[KEY_REC_SIZE];
+
+    rec[0] = d.key;
+    put_uint(rec + 1, (unsigned long long)(Uint32)d.sdl_key, 4);
+    rec[5] = (d.is_shift_held ? SHIFT_FLAG : 0) | (d.is_ctrl_held ? CTRL_FLAG : 0);
+
+    //Flushed for each key, so that the replay is complete even if the game crashes
+    //(keys are only read at human speed, so this is cheap)
+    rec_file_.write(rec, KEY_REC_SIZE);
+    rec_file_.flush();
+}
+
+} //replay
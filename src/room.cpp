@@ -20,7 +20,7 @@ using namespace std;
 namespace
 {
 
-vector<Room_type> room_bucket_;
+thread_local vector<Room_type> room_bucket_;
 
 void add_to_room_bucket(const Room_type type, const size_t NR)
 {
@@ -88,7 +88,7 @@ void init_room_bucket()
         add_to_room_bucket(Room_type::forest,   rnd::range(1, 4));
     }
 
-    std::random_shuffle(begin(room_bucket_), end(room_bucket_));
+    rnd::shuffle(begin(room_bucket_), end(room_bucket_));
 
     TRACE_FUNC_END;
 }
@@ -970,7 +970,7 @@ void Forest_room::on_post_connect_(bool door_proposals[MAP_W][MAP_H])
         }
     }
 
-    random_shuffle(begin(tree_pos_bucket), end(tree_pos_bucket));
+    rnd::shuffle(begin(tree_pos_bucket), end(tree_pos_bucket));
 
     int nr_trees_placed = 0;
 
@@ -1334,7 +1334,7 @@ void River_room::on_pre_connect(bool door_proposals[MAP_W][MAP_H])
 
     vector<int> coordinates(IS_HOR ? MAP_W : MAP_H);
     iota(begin(coordinates), end(coordinates), 0);
-    random_shuffle(coordinates.begin(), coordinates.end());
+    rnd::shuffle(coordinates.begin(), coordinates.end());
 
     vector<int> c_built;
 
@@ -1,6 +1,7 @@
 #include "sdl_wrapper.hpp"
 
 #include <iostream>
+#include <algorithm>
 
 #include <SDL_image.h>
 #include <SDL_mixer.h>
@@ -19,6 +20,12 @@ namespace
 
 bool is_inited = false;
 
+//When the last delay ended (or should have ended), see sleep()
+Uint32 prev_sleep_end_ticks_ = 0;
+
+//Longest time to sleep between pumping events during a delay
+const Uint32 MAX_SLEEP_STEP_MS = 10;
+
 }
 
 void init()
@@ -27,7 +34,19 @@ void init()
 
     is_inited = true;
 
-    if (SDL_Init(SDL_INIT_EVERYTHING) == -1)
+    //Video is only needed for presenting in a window
+    const Uint32 SDL_INIT_FLAGS = config::render_backend() == Render_backend::sdl ?
+                                  SDL_INIT_EVERYTHING :
+                                  SDL_INIT_EVERYTHING & ~SDL_INIT_VIDEO;
+
+    //Nothing is heard when nothing is seen (this also allows running without any audio
+    //device, e.g. for the headless bot)
+    if (config::render_backend() != Render_backend::sdl)
+    {
+        SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+    }
+
+    if (SDL_Init(SDL_INIT_FLAGS) == -1)
     {
         TRACE << "Failed to init SDL" << endl;
         assert(false);
@@ -68,15 +87,33 @@ void sleep(const Uint32 DURATION)
 {
     if (is_inited && !config::is_bot_playing())
     {
-        if (DURATION == 1)
-        {
-            SDL_Delay(DURATION);
-        }
-        else
+        const Uint32 NOW = SDL_GetTicks();
+
+        //Animations draw a frame and then sleep, repeatedly. If the previous delay ended
+        //less than one frame ago, this delay is timed from when that one ended. This way
+        //the time spent drawing is part of the frame time, and animations run at a
+        //steady speed regardless of how long the drawing takes.
+        const bool IS_NXT_FRAME = Sint32(NOW - prev_sleep_end_ticks_) <= Sint32(DURATION);
+
+        const Uint32 START = IS_NXT_FRAME ? prev_sleep_end_ticks_ : NOW;
+        const Uint32 END   = START + DURATION;
+
+        prev_sleep_end_ticks_ = END;
+
+        //Sleep (instead of spinning) until the end time, but keep pumping the events now
+        //and then, so the window stays responsive
+        while (true)
         {
-            const Uint32 WAIT_UNTIL = SDL_GetTicks() + DURATION;
+            const Sint32 TIME_LEFT = Sint32(END - SDL_GetTicks());
+
+            if (TIME_LEFT <= 0)
+            {
+                break;
+            }
+
+            SDL_Delay(min(Uint32(TIME_LEFT), MAX_SLEEP_STEP_MS));
 
-            while (SDL_GetTicks() < WAIT_UNTIL) {SDL_PumpEvents();}
+            SDL_PumpEvents();
         }
     }
 }
@@ -35,7 +35,70 @@ namespace snd_emit
 namespace
 {
 
-int nr_snd_msg_printed_cur_turn_;
+thread_local int nr_snd_msg_printed_cur_turn_;
+
+//Sound distances from an origin. Nothing further away than the loud sound distance can
+//hear anything, so the flood fill stops there. The most recent fields are kept for the
+//current turn (as long as the map is unchanged), since the same cell often makes several
+//sounds in a row (e.g. machine gun bursts).
+struct Snd_dist_field
+{
+    Pos origin;
+    int dist[MAP_W][MAP_H];
+};
+
+const size_t NR_CACHED_SND_FIELDS = 4;
+
+thread_local Snd_dist_field  snd_fields_[NR_CACHED_SND_FIELDS];
+thread_local size_t          nr_snd_fields_              = 0;
+thread_local size_t          next_snd_field_to_replace_  = 0;
+thread_local int             snd_fields_turn_            = -1;
+thread_local int             snd_fields_obstr_revision_  = -1;
+
+const Snd_dist_field& snd_dist_field(const Pos& origin)
+{
+    if (
+        snd_fields_turn_            != game_time::turn() ||
+        snd_fields_obstr_revision_  != map::obstr_revision())
+    {
+        nr_snd_fields_              = 0;
+        next_snd_field_to_replace_  = 0;
+        snd_fields_turn_            = game_time::turn();
+        snd_fields_obstr_revision_  = map::obstr_revision();
+    }
+
+    for (size_t i = 0; i < nr_snd_fields_; ++i)
+    {
+        if (snd_fields_[i].origin == origin)
+        {
+            return snd_fields_[i];
+        }
+    }
+
+    size_t idx = nr_snd_fields_;
+
+    if (nr_snd_fields_ < NR_CACHED_SND_FIELDS)
+    {
+        ++nr_snd_fields_;
+    }
+    else //All fields used - replace the oldest one
+    {
+        idx = next_snd_field_to_replace_;
+
+        next_snd_field_to_replace_ = (next_snd_field_to_replace_ + 1) % NR_CACHED_SND_FIELDS;
+    }
+
+    Snd_dist_field& field = snd_fields_[idx];
+
+    bool blocked[MAP_W][MAP_H];
+    map::obstr_layer(Obstr_layer::sound).to_array(blocked);
+
+    field.origin = origin;
+
+    flood_fill::run(origin, blocked, field.dist, SND_DIST_LOUD, Pos(-1, -1), true);
+
+    return field;
+}
 
 bool is_snd_heard_at_range(const int RANGE, const Snd& snd)
 {
@@ -51,25 +114,38 @@ void reset_nr_snd_msg_printed_cur_turn()
 
 void emit_snd(Snd snd)
 {
-    bool blocked[MAP_W][MAP_H];
+    const Pos& origin = snd.origin();
+
+    //NOTE: The distances are looked up for all actors before any actor hears the sound,
+    //since hearing it may cause new sounds (which may replace the cached field)
+    vector<int> dist_at_actors;
+    dist_at_actors.reserve(game_time::actors_.size());
 
-    for (int x = 0; x < MAP_W; ++x)
     {
-        for (int y = 0; y < MAP_H; ++y)
+        const Snd_dist_field& field = snd_dist_field(origin);
+
+        for (const Actor* const actor : game_time::actors_)
         {
-            const auto f  = map::cells[x][y].rigid;
-            blocked[x][y] = !f->is_sound_passable();
+            const Pos& p = actor->pos;
+
+            //Zero means either the origin itself, or not reached
+            const int DIST = field.dist[p.x][p.y];
+
+            dist_at_actors.push_back((DIST == 0 && p != origin) ? -1 : DIST);
         }
     }
 
-    int flood_fill[MAP_W][MAP_H];
-    const Pos& origin = snd.origin();
-    flood_fill::run(origin, blocked, flood_fill, 999, Pos(-1, -1), true);
-    flood_fill[origin.x][origin.y] = 0;
-
-    for (Actor* actor : game_time::actors_)
+    for (size_t i = 0; i < dist_at_actors.size(); ++i)
     {
-        const int FLOOD_VALUE_AT_ACTOR = flood_fill[actor->pos.x][actor->pos.y];
+        Actor* const actor = game_time::actors_[i];
+
+        const int FLOOD_VALUE_AT_ACTOR = dist_at_actors[i];
+
+        if (FLOOD_VALUE_AT_ACTOR < 0)
+        {
+            //Sound does not reach the actor
+            continue;
+        }
 
         const bool IS_ORIGIN_SEEN_BY_PLAYER =
             map::cells[origin.x][origin.y].is_seen_by_player;
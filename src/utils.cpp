@@ -9,6 +9,7 @@
 #include "mersenne_twister.hpp"
 #include "actor.hpp"
 #include "feature_mob.hpp"
+#include "map_bits.hpp"
 
 using namespace std;
 
@@ -18,7 +19,9 @@ namespace rnd
 namespace
 {
 
-MTRand mt_rand;
+thread_local MTRand mt_rand;
+
+thread_local unsigned long seed_ = 0;
 
 int roll(const int ROLLS, const int SIDES)
 {
@@ -40,9 +43,15 @@ int roll(const int ROLLS, const int SIDES)
 
 void seed(const unsigned long val)
 {
+    seed_   = val;
     mt_rand = MTRand(val);
 }
 
+unsigned long cur_seed()
+{
+    return seed_;
+}
+
 int dice(const int ROLLS, const int SIDES)
 {
     return roll(ROLLS, SIDES);
@@ -141,6 +150,11 @@ void reverse_bool_array(bool array[MAP_W][MAP_H])
     }
 }
 
+void reverse_bool_array(Map_bits& array)
+{
+    array.invert();
+}
+
 void copy_bool_array(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H])
 {
     for (int x = 0; x < MAP_W; ++x)
@@ -152,6 +166,11 @@ void copy_bool_array(const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H])
     }
 }
 
+void copy_bool_array(const Map_bits& in, Map_bits& out)
+{
+    out = in;
+}
+
 void mk_vector_from_bool_map(const bool VALUE_TO_STORE, const bool a[MAP_W][MAP_H],
                              vector<Pos>& out)
 {
@@ -185,9 +204,11 @@ void actor_cells(const vector<Actor*>& actors, vector<Pos>& out)
 
 Actor* actor_at_pos(const Pos& pos, Actor_state state)
 {
-    for (auto* const actor : game_time::actors_)
+    if (!is_pos_inside_map(pos)) {return nullptr;}
+
+    for (auto* const actor : game_time::actors_at_pos(pos))
     {
-        if (actor->pos == pos && actor->state() == state)
+        if (actor->state() == state)
         {
             return actor;
         }
@@ -198,12 +219,11 @@ Actor* actor_at_pos(const Pos& pos, Actor_state state)
 
 Mob* first_mob_at_pos(const Pos& pos)
 {
-    for (auto* const mob : game_time::mobs_)
-    {
-        if (mob->pos() == pos) {return mob;}
-    }
+    if (!is_pos_inside_map(pos)) {return nullptr;}
 
-    return nullptr;
+    const vector<Mob*>& mobs = game_time::mobs_at_pos(pos);
+
+    return mobs.empty() ? nullptr : mobs.front();
 }
 
 void mk_actor_array(Actor* a[MAP_W][MAP_H])
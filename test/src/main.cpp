@@ -1,38 +1,48 @@
-#include "Init.h"
+#include "init.hpp"
 
 #include "UnitTest++.h"
 
 #include <climits>
 #include <string>
+#include <algorithm>
+#include <memory>
 
 #include <SDL.h>
 
-#include "Config.h"
-#include "utils.h"
-#include "render.h"
-#include "map.h"
-#include "ActorPlayer.h"
-#include "Throwing.h"
-#include "ItemFactory.h"
-#include "TextFormat.h"
-#include "ActorFactory.h"
-#include "ActorMon.h"
-#include "mapGen.h"
-#include "Converters.h"
-#include "CmnTypes.h"
-#include "mapParsing.h"
-#include "fov.h"
-#include "LineCalc.h"
-#include "SaveHandling.h"
-#include "Inventory.h"
-#include "PlayerSpellsHandling.h"
-#include "PlayerBon.h"
-#include "Explosion.h"
-#include "ItemDevice.h"
-#include "FeatureRigid.h"
-#include "FeatureTrap.h"
-#include "Drop.h"
-#include "mapTravel.h"
+#include "config.hpp"
+#include "utils.hpp"
+#include "render.hpp"
+#include "map.hpp"
+#include "actor_player.hpp"
+#include "throwing.hpp"
+#include "item_factory.hpp"
+#include "text_format.hpp"
+#include "actor_factory.hpp"
+#include "actor_mon.hpp"
+#include "actor_data.hpp"
+#include "map_gen.hpp"
+#include "converters.hpp"
+#include "cmn_types.hpp"
+#include "map_parsing.hpp"
+#include "fov.hpp"
+#include "line_calc.hpp"
+#include "save_handling.hpp"
+#include "inventory.hpp"
+#include "player_spells_handling.hpp"
+#include "player_bon.hpp"
+#include "explosion.hpp"
+#include "item.hpp"
+#include "item_data.hpp"
+#include "item_device.hpp"
+#include "feature_data.hpp"
+#include "feature_rigid.hpp"
+#include "feature_trap.hpp"
+#include "feature_mob.hpp"
+#include "drop.hpp"
+#include "map_travel.hpp"
+#include "game_time.hpp"
+#include "properties.hpp"
+#include "room.hpp"
 
 using namespace std;
 
@@ -40,52 +50,51 @@ struct BasicFixture
 {
     BasicFixture()
     {
-        init::initGame();
-        init::initSession();
-        map::player->pos = Pos(1, 1);
-        map::resetmap(); //Because map generation is not run
+        init::init_game();
+        init::init_session();
+        map::player->set_pos(Pos(1, 1));
+        map::reset_map(); //Because map generation is not run
     }
     ~BasicFixture()
     {
-        init::cleanupSession();
-        init::cleanupGame();
+        init::cleanup_session();
+        init::cleanup_game();
     }
 };
 
 TEST(IsValInRange)
 {
     //Check in range
-    CHECK(utils::isValInRange(5,    Range(3,  7)));
-    CHECK(utils::isValInRange(3,    Range(3,  7)));
-    CHECK(utils::isValInRange(7,    Range(3,  7)));
-    CHECK(utils::isValInRange(10,   Range(-5, 12)));
-    CHECK(utils::isValInRange(-5,   Range(-5, 12)));
-    CHECK(utils::isValInRange(12,   Range(-5, 12)));
+    CHECK(utils::is_val_in_range(5,    Range(3,  7)));
+    CHECK(utils::is_val_in_range(3,    Range(3,  7)));
+    CHECK(utils::is_val_in_range(7,    Range(3,  7)));
+    CHECK(utils::is_val_in_range(10,   Range(-5, 12)));
+    CHECK(utils::is_val_in_range(-5,   Range(-5, 12)));
+    CHECK(utils::is_val_in_range(12,   Range(-5, 12)));
 
-    CHECK(utils::isValInRange(0,    Range(-1,  1)));
-    CHECK(utils::isValInRange(-1,   Range(-1,  1)));
-    CHECK(utils::isValInRange(1,    Range(-1,  1)));
+    CHECK(utils::is_val_in_range(0,    Range(-1,  1)));
+    CHECK(utils::is_val_in_range(-1,   Range(-1,  1)));
+    CHECK(utils::is_val_in_range(1,    Range(-1,  1)));
 
-    CHECK(utils::isValInRange(5,    Range(5,  5)));
+    CHECK(utils::is_val_in_range(5,    Range(5,  5)));
 
     //Check NOT in range
-    CHECK(!utils::isValInRange(2,   Range(3,  7)));
-    CHECK(!utils::isValInRange(8,   Range(3,  7)));
-    CHECK(!utils::isValInRange(-1,  Range(3,  7)));
+    CHECK(!utils::is_val_in_range(2,   Range(3,  7)));
+    CHECK(!utils::is_val_in_range(8,   Range(3,  7)));
+    CHECK(!utils::is_val_in_range(-1,  Range(3,  7)));
 
-    CHECK(!utils::isValInRange(-9,  Range(-5, 12)));
-    CHECK(!utils::isValInRange(13,  Range(-5, 12)));
+    CHECK(!utils::is_val_in_range(-9,  Range(-5, 12)));
+    CHECK(!utils::is_val_in_range(13,  Range(-5, 12)));
 
-    CHECK(!utils::isValInRange(0,   Range(1,  2)));
+    CHECK(!utils::is_val_in_range(0,   Range(1,  2)));
 
-    CHECK(!utils::isValInRange(4,   Range(5,  5)));
-    CHECK(!utils::isValInRange(6,   Range(5,  5)));
+    CHECK(!utils::is_val_in_range(4,   Range(5,  5)));
+    CHECK(!utils::is_val_in_range(6,   Range(5,  5)));
 
     //NOTE: Reversed range settings (e.g. Range(7, 3)) will fail an assert on debug builds.
-    //For release builds, this will reverse the result - i.e. isValInRange(1, Range(7, 3))
+    //For release builds, this will reverse the result - i.e. is_val_in_range(1, Range(7, 3))
     //will return true.
 }
-
 TEST(RollDice)
 {
     int val = rnd::range(100, 200);
@@ -94,93 +103,129 @@ TEST(RollDice)
     CHECK(val >= -1 && val <= 1);
 }
 
+TEST(ShuffleIsDecidedBySeed)
+{
+    vector<int> v1;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        v1.push_back(i);
+    }
+
+    vector<int> v2 = v1;
+
+    rnd::seed(1234);
+    rnd::shuffle(begin(v1), end(v1));
+
+    rnd::seed(1234);
+    rnd::shuffle(begin(v2), end(v2));
+
+    CHECK(v1 == v2);
+
+    //Still a permutation of the original elements
+    vector<int> sorted = v1;
+    sort(begin(sorted), end(sorted));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK_EQUAL(i, sorted[i]);
+    }
+
+    //Empty and single element ranges are fine
+    vector<int> v3;
+    rnd::shuffle(begin(v3), end(v3));
+    v3.push_back(7);
+    rnd::shuffle(begin(v3), end(v3));
+    CHECK_EQUAL(7, v3[0]);
+}
+
 TEST(ConstrainValInRange)
 {
-    int val = getConstrInRange(5, 9, 10);
+    int val = constr_in_range(5, 9, 10);
     CHECK_EQUAL(val, 9);
-    val = getConstrInRange(5, 11, 10);
+    val = constr_in_range(5, 11, 10);
     CHECK_EQUAL(val, 10);
-    val = getConstrInRange(5, 4, 10);
+    val = constr_in_range(5, 4, 10);
     CHECK_EQUAL(val, 5);
 
-    constrInRange(2, val, 8);
+    set_constr_in_range(2, val, 8);
     CHECK_EQUAL(val, 5);
-    constrInRange(2, val, 4);
+    set_constr_in_range(2, val, 4);
     CHECK_EQUAL(val, 4);
-    constrInRange(18, val, 22);
+    set_constr_in_range(18, val, 22);
     CHECK_EQUAL(val, 18);
 
     //Test faulty paramters
-    val = getConstrInRange(9, 4, 2);   //Min > Max -> return -1
+    val = constr_in_range(9, 4, 2);   //Min > Max -> return -1
     CHECK_EQUAL(val, -1);
     val = 10;
-    constrInRange(20, val, 3);   //Min > Max -> do nothing
+    set_constr_in_range(20, val, 3);   //Min > Max -> do nothing
     CHECK_EQUAL(val, 10);
 }
 
 TEST(CalculateDistances)
 {
-    CHECK_EQUAL(utils::kingDist(Pos(1, 2), Pos(2, 3)), 1);
-    CHECK_EQUAL(utils::kingDist(Pos(1, 2), Pos(2, 4)), 2);
-    CHECK_EQUAL(utils::kingDist(Pos(1, 2), Pos(1, 2)), 0);
-    CHECK_EQUAL(utils::kingDist(Pos(10, 3), Pos(1, 4)), 9);
+    CHECK_EQUAL(utils::king_dist(Pos(1, 2), Pos(2, 3)), 1);
+    CHECK_EQUAL(utils::king_dist(Pos(1, 2), Pos(2, 4)), 2);
+    CHECK_EQUAL(utils::king_dist(Pos(1, 2), Pos(1, 2)), 0);
+    CHECK_EQUAL(utils::king_dist(Pos(10, 3), Pos(1, 4)), 9);
 }
 
 TEST(Directions)
 {
     const int X0 = 20;
     const int Y0 = 20;
-    const Pos fromPos(X0, Y0);
+    const Pos from_pos(X0, Y0);
     string str = "";
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 1, Y0), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 1, Y0), str);
     CHECK_EQUAL("E", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 1, Y0 + 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 1, Y0 + 1), str);
     CHECK_EQUAL("SE", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0    , Y0 + 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0    , Y0 + 1), str);
     CHECK_EQUAL("S", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 1, Y0 + 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 1, Y0 + 1), str);
     CHECK_EQUAL("SW", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 1, Y0), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 1, Y0), str);
     CHECK_EQUAL("W", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 1, Y0 - 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 1, Y0 - 1), str);
     CHECK_EQUAL("NW", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0    , Y0 - 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0    , Y0 - 1), str);
     CHECK_EQUAL("N", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 1, Y0 - 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 1, Y0 - 1), str);
     CHECK_EQUAL("NE", str);
 
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 3, Y0 + 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 3, Y0 + 1), str);
     CHECK_EQUAL("E", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 2, Y0 + 3), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 2, Y0 + 3), str);
     CHECK_EQUAL("SE", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 1, Y0 + 3), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 1, Y0 + 3), str);
     CHECK_EQUAL("S", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 3, Y0 + 2), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 3, Y0 + 2), str);
     CHECK_EQUAL("SW", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 3, Y0 + 1), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 3, Y0 + 1), str);
     CHECK_EQUAL("W", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 3, Y0 - 2), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 3, Y0 - 2), str);
     CHECK_EQUAL("NW", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 1, Y0 - 3), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 1, Y0 - 3), str);
     CHECK_EQUAL("N", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 3, Y0 - 2), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 3, Y0 - 2), str);
     CHECK_EQUAL("NE", str);
 
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 10000, Y0), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 10000, Y0), str);
     CHECK_EQUAL("E", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 10000, Y0 + 10000), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 10000, Y0 + 10000), str);
     CHECK_EQUAL("SE", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0        , Y0 + 10000), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0        , Y0 + 10000), str);
     CHECK_EQUAL("S", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 10000, Y0 + 10000), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 10000, Y0 + 10000), str);
     CHECK_EQUAL("SW", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 10000, Y0), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 10000, Y0), str);
     CHECK_EQUAL("W", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 - 10000, Y0 - 10000), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 - 10000, Y0 - 10000), str);
     CHECK_EQUAL("NW", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0        , Y0 - 10000), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0        , Y0 - 10000), str);
     CHECK_EQUAL("N", str);
-    Dirutils::getCompassDirName(fromPos, Pos(X0 + 10000, Y0 - 10000), str);
+    dir_utils::compass_dir_name(from_pos, Pos(X0 + 10000, Y0 - 10000), str);
     CHECK_EQUAL("NE", str);
 }
 
@@ -188,52 +233,52 @@ TEST(FormatText)
 {
     string str = "one two three four";
 
-    vector<string> formattedLines;
-
-    int lineMaxW = 100;
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL(str, formattedLines[0]);
-    CHECK_EQUAL(1, int(formattedLines.size()));
-
-    lineMaxW = 18;
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL("one two three four", formattedLines[0]);
-    CHECK_EQUAL(1, int(formattedLines.size()));
-
-    lineMaxW = 17;
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL("one two three",    formattedLines[0]);
-    CHECK_EQUAL("four",             formattedLines[1]);
-    CHECK_EQUAL(2, int(formattedLines.size()));
-
-    lineMaxW = 15;
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL("one two three",    formattedLines[0]);
-    CHECK_EQUAL("four",             formattedLines[1]);
-    CHECK_EQUAL(2, int(formattedLines.size()));
-
-    lineMaxW = 11;
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL("one two",          formattedLines[0]);
-    CHECK_EQUAL("three four",       formattedLines[1]);
-    CHECK_EQUAL(2, int(formattedLines.size()));
-
-    lineMaxW    = 4;
+    vector<string> formatted_lines;
+
+    int line_max_w = 100;
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL(str, formatted_lines[0]);
+    CHECK_EQUAL(1, int(formatted_lines.size()));
+
+    line_max_w = 18;
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL("one two three four", formatted_lines[0]);
+    CHECK_EQUAL(1, int(formatted_lines.size()));
+
+    line_max_w = 17;
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL("one two three",    formatted_lines[0]);
+    CHECK_EQUAL("four",             formatted_lines[1]);
+    CHECK_EQUAL(2, int(formatted_lines.size()));
+
+    line_max_w = 15;
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL("one two three",    formatted_lines[0]);
+    CHECK_EQUAL("four",             formatted_lines[1]);
+    CHECK_EQUAL(2, int(formatted_lines.size()));
+
+    line_max_w = 11;
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL("one two",          formatted_lines[0]);
+    CHECK_EQUAL("three four",       formatted_lines[1]);
+    CHECK_EQUAL(2, int(formatted_lines.size()));
+
+    line_max_w    = 4;
     str         = "123456";
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL("123456",           formattedLines[0]);
-    CHECK_EQUAL(1, int(formattedLines.size()));
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL("123456",           formatted_lines[0]);
+    CHECK_EQUAL(1, int(formatted_lines.size()));
 
-    lineMaxW    = 4;
+    line_max_w    = 4;
     str         = "12 345678";
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK_EQUAL("12",               formattedLines[0]);
-    CHECK_EQUAL("345678",           formattedLines[1]);
-    CHECK_EQUAL(2, int(formattedLines.size()));
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK_EQUAL("12",               formatted_lines[0]);
+    CHECK_EQUAL("345678",           formatted_lines[1]);
+    CHECK_EQUAL(2, int(formatted_lines.size()));
 
     str = "";
-    TextFormat::lineToLines(str, lineMaxW, formattedLines);
-    CHECK(formattedLines.empty());
+    text_format::line_to_lines(str, line_max_w, formatted_lines);
+    CHECK(formatted_lines.empty());
 }
 
 TEST_FIXTURE(BasicFixture, LineCalculation)
@@ -241,63 +286,63 @@ TEST_FIXTURE(BasicFixture, LineCalculation)
     Pos origin(0, 0);
     vector<Pos> line;
 
-    LineCalc::calcNewLine(origin, Pos(3, 0), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(3, 0), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(1, 0));
     CHECK(line[2] == Pos(2, 0));
     CHECK(line[3] == Pos(3, 0));
 
-    LineCalc::calcNewLine(origin, Pos(-3, 0), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(-3, 0), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(-1, 0));
     CHECK(line[2] == Pos(-2, 0));
     CHECK(line[3] == Pos(-3, 0));
 
-    LineCalc::calcNewLine(origin, Pos(0, 3), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(0, 3), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(0, 1));
     CHECK(line[2] == Pos(0, 2));
     CHECK(line[3] == Pos(0, 3));
 
-    LineCalc::calcNewLine(origin, Pos(0, -3), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(0, -3), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(0, -1));
     CHECK(line[2] == Pos(0, -2));
     CHECK(line[3] == Pos(0, -3));
 
-    LineCalc::calcNewLine(origin, Pos(3, 3), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(3, 3), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(1, 1));
     CHECK(line[2] == Pos(2, 2));
     CHECK(line[3] == Pos(3, 3));
 
-    LineCalc::calcNewLine(Pos(9, 9), Pos(6, 12), true, 999, true, line);
+    line_calc::calc_new_line(Pos(9, 9), Pos(6, 12), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == Pos(9, 9));
     CHECK(line[1] == Pos(8, 10));
     CHECK(line[2] == Pos(7, 11));
     CHECK(line[3] == Pos(6, 12));
 
-    LineCalc::calcNewLine(origin, Pos(-3, 3), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(-3, 3), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(-1, 1));
     CHECK(line[2] == Pos(-2, 2));
     CHECK(line[3] == Pos(-3, 3));
 
-    LineCalc::calcNewLine(origin, Pos(3, -3), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(3, -3), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(1, -1));
     CHECK(line[2] == Pos(2, -2));
     CHECK(line[3] == Pos(3, -3));
 
-    LineCalc::calcNewLine(origin, Pos(-3, -3), true, 999, true, line);
+    line_calc::calc_new_line(origin, Pos(-3, -3), true, 999, true, line);
     CHECK(line.size() == 4);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(-1, -1));
@@ -305,88 +350,88 @@ TEST_FIXTURE(BasicFixture, LineCalculation)
     CHECK(line[3] == Pos(-3, -3));
 
     //Test disallowing outside map
-    LineCalc::calcNewLine(Pos(1, 0), Pos(-9, 0), true, 999, false, line);
+    line_calc::calc_new_line(Pos(1, 0), Pos(-9, 0), true, 999, false, line);
     CHECK(line.size() == 2);
     CHECK(line[0] == Pos(1, 0));
     CHECK(line[1] == Pos(0, 0));
 
     //Test travel limit parameter
-    LineCalc::calcNewLine(origin, Pos(20, 0), true, 2, true, line);
+    line_calc::calc_new_line(origin, Pos(20, 0), true, 2, true, line);
     CHECK(line.size() == 3);
     CHECK(line[0] == origin);
     CHECK(line[1] == Pos(1, 0));
     CHECK(line[2] == Pos(2, 0));
 
     //Test precalculated FOV line offsets
-    const vector<Pos>* deltaLine =
-        LineCalc::getfovDeltaLine(Pos(3, 3), FOV_STD_RADI_DB);
-    CHECK(deltaLine->size() == 4);
-    CHECK(deltaLine->at(0) == Pos(0, 0));
-    CHECK(deltaLine->at(1) == Pos(1, 1));
-    CHECK(deltaLine->at(2) == Pos(2, 2));
-    CHECK(deltaLine->at(3) == Pos(3, 3));
-
-    deltaLine =
-        LineCalc::getfovDeltaLine(Pos(-3, 3), FOV_STD_RADI_DB);
-    CHECK(deltaLine->size() == 4);
-    CHECK(deltaLine->at(0) == Pos(0, 0));
-    CHECK(deltaLine->at(1) == Pos(-1, 1));
-    CHECK(deltaLine->at(2) == Pos(-2, 2));
-    CHECK(deltaLine->at(3) == Pos(-3, 3));
-
-    deltaLine =
-        LineCalc::getfovDeltaLine(Pos(3, -3), FOV_STD_RADI_DB);
-    CHECK(deltaLine->size() == 4);
-    CHECK(deltaLine->at(0) == Pos(0, 0));
-    CHECK(deltaLine->at(1) == Pos(1, -1));
-    CHECK(deltaLine->at(2) == Pos(2, -2));
-    CHECK(deltaLine->at(3) == Pos(3, -3));
-
-    deltaLine =
-        LineCalc::getfovDeltaLine(Pos(-3, -3), FOV_STD_RADI_DB);
-    CHECK(deltaLine->size() == 4);
-    CHECK(deltaLine->at(0) == Pos(0, 0));
-    CHECK(deltaLine->at(1) == Pos(-1, -1));
-    CHECK(deltaLine->at(2) == Pos(-2, -2));
-    CHECK(deltaLine->at(3) == Pos(-3, -3));
+    const vector<Pos>* delta_line =
+        line_calc::fov_delta_line(Pos(3, 3), FOV_STD_RADI_DB);
+    CHECK(delta_line->size() == 4);
+    CHECK(delta_line->at(0) == Pos(0, 0));
+    CHECK(delta_line->at(1) == Pos(1, 1));
+    CHECK(delta_line->at(2) == Pos(2, 2));
+    CHECK(delta_line->at(3) == Pos(3, 3));
+
+    delta_line =
+        line_calc::fov_delta_line(Pos(-3, 3), FOV_STD_RADI_DB);
+    CHECK(delta_line->size() == 4);
+    CHECK(delta_line->at(0) == Pos(0, 0));
+    CHECK(delta_line->at(1) == Pos(-1, 1));
+    CHECK(delta_line->at(2) == Pos(-2, 2));
+    CHECK(delta_line->at(3) == Pos(-3, 3));
+
+    delta_line =
+        line_calc::fov_delta_line(Pos(3, -3), FOV_STD_RADI_DB);
+    CHECK(delta_line->size() == 4);
+    CHECK(delta_line->at(0) == Pos(0, 0));
+    CHECK(delta_line->at(1) == Pos(1, -1));
+    CHECK(delta_line->at(2) == Pos(2, -2));
+    CHECK(delta_line->at(3) == Pos(3, -3));
+
+    delta_line =
+        line_calc::fov_delta_line(Pos(-3, -3), FOV_STD_RADI_DB);
+    CHECK(delta_line->size() == 4);
+    CHECK(delta_line->at(0) == Pos(0, 0));
+    CHECK(delta_line->at(1) == Pos(-1, -1));
+    CHECK(delta_line->at(2) == Pos(-2, -2));
+    CHECK(delta_line->at(3) == Pos(-3, -3));
 
     //Check constraints for retrieving FOV offset lines
     //Delta > parameter max distance
-    deltaLine = LineCalc::getfovDeltaLine(Pos(3, 0), 2);
-    CHECK(!deltaLine);
+    delta_line = line_calc::fov_delta_line(Pos(3, 0), 2);
+    CHECK(!delta_line);
     //Delta > limit of precalculated
-    deltaLine = LineCalc::getfovDeltaLine(Pos(50, 0), 999);
-    CHECK(!deltaLine);
+    delta_line = line_calc::fov_delta_line(Pos(50, 0), 999);
+    CHECK(!delta_line);
 }
 
 TEST_FIXTURE(BasicFixture, fov)
 {
     bool blocked[MAP_W][MAP_H];
 
-    utils::resetArray(blocked, false);   //Nothing blocking sight
+    utils::reset_array(blocked, false);   //Nothing blocking sight
 
     const int X = MAP_W_HALF;
     const int Y = MAP_H_HALF;
 
-    map::player->pos = Pos(X, Y);
+    map::player->set_pos(Pos(X, Y));
 
-    fov::runPlayerfov(blocked, map::player->pos);
+    fov::run_player_fov(blocked, map::player->pos);
 
     const int R = FOV_STD_RADI_INT;
 
-    CHECK(map::cells[X    ][Y    ].isSeenByPlayer);
-    CHECK(map::cells[X + 1][Y    ].isSeenByPlayer);
-    CHECK(map::cells[X - 1][Y    ].isSeenByPlayer);
-    CHECK(map::cells[X    ][Y + 1].isSeenByPlayer);
-    CHECK(map::cells[X    ][Y - 1].isSeenByPlayer);
-    CHECK(map::cells[X + 2][Y + 2].isSeenByPlayer);
-    CHECK(map::cells[X - 2][Y + 2].isSeenByPlayer);
-    CHECK(map::cells[X + 2][Y - 2].isSeenByPlayer);
-    CHECK(map::cells[X - 2][Y - 2].isSeenByPlayer);
-    CHECK(map::cells[X + R][Y    ].isSeenByPlayer);
-    CHECK(map::cells[X - R][Y    ].isSeenByPlayer);
-    CHECK(map::cells[X    ][Y + R].isSeenByPlayer);
-    CHECK(map::cells[X    ][Y - R].isSeenByPlayer);
+    CHECK(map::cells[X    ][Y    ].is_seen_by_player);
+    CHECK(map::cells[X + 1][Y    ].is_seen_by_player);
+    CHECK(map::cells[X - 1][Y    ].is_seen_by_player);
+    CHECK(map::cells[X    ][Y + 1].is_seen_by_player);
+    CHECK(map::cells[X    ][Y - 1].is_seen_by_player);
+    CHECK(map::cells[X + 2][Y + 2].is_seen_by_player);
+    CHECK(map::cells[X - 2][Y + 2].is_seen_by_player);
+    CHECK(map::cells[X + 2][Y - 2].is_seen_by_player);
+    CHECK(map::cells[X - 2][Y - 2].is_seen_by_player);
+    CHECK(map::cells[X + R][Y    ].is_seen_by_player);
+    CHECK(map::cells[X - R][Y    ].is_seen_by_player);
+    CHECK(map::cells[X    ][Y + R].is_seen_by_player);
+    CHECK(map::cells[X    ][Y - R].is_seen_by_player);
 }
 
 TEST_FIXTURE(BasicFixture, ThrowItems)
@@ -405,10 +450,10 @@ TEST_FIXTURE(BasicFixture, ThrowItems)
     map::put(new Floor(Pos(5, 7)));
     map::put(new Floor(Pos(5, 9)));
     map::put(new Floor(Pos(5, 10)));
-    map::player->pos = Pos(5, 10);
+    map::player->set_pos(Pos(5, 10));
     Pos tgt(5, 8);
-    Item* item = ItemFactory::mk(ItemId::thrKnife);
-    throwing::throwItem(*(map::player), tgt, *item);
+    Item* item = item_factory::mk(Item_id::thr_knife);
+    throwing::throw_item(*(map::player), tgt, *item);
     CHECK(map::cells[5][9].item);
 }
 
@@ -423,35 +468,35 @@ TEST_FIXTURE(BasicFixture, Explosions)
     //Check wall destruction
     for (int i = 0; i < 2; ++i)
     {
-        explosion::runExplosionAt(Pos(X0, Y0), ExplType::expl);
+        explosion::run_explosion_at(Pos(X0, Y0), Expl_type::expl);
 
         //Cells around the center, at a distance of 1, should be destroyed
         int r = 1;
-        CHECK(map::cells[X0 + r][Y0    ].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0 - r][Y0    ].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0    ][Y0 + r].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0    ][Y0 - r].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0 + r][Y0 + r].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0 + r][Y0 - r].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0 - r][Y0 + r].rigid->getId() != FeatureId::wall);
-        CHECK(map::cells[X0 - r][Y0 - r].rigid->getId() != FeatureId::wall);
+        CHECK(map::cells[X0 + r][Y0    ].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0 - r][Y0    ].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0    ][Y0 + r].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0    ][Y0 - r].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0 + r][Y0 + r].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0 + r][Y0 - r].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0 - r][Y0 + r].rigid->id() != Feature_id::wall);
+        CHECK(map::cells[X0 - r][Y0 - r].rigid->id() != Feature_id::wall);
 
         //Cells around the center, at a distance of 2, should NOT be destroyed
         r = 2;
-        CHECK(map::cells[X0 + r][Y0    ].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0 - r][Y0    ].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0    ][Y0 + r].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0    ][Y0 - r].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0 + r][Y0 + r].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0 + r][Y0 - r].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0 - r][Y0 + r].rigid->getId() == FeatureId::wall);
-        CHECK(map::cells[X0 - r][Y0 - r].rigid->getId() == FeatureId::wall);
+        CHECK(map::cells[X0 + r][Y0    ].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0 - r][Y0    ].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0    ][Y0 + r].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0    ][Y0 - r].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0 + r][Y0 + r].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0 + r][Y0 - r].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0 - r][Y0 + r].rigid->id() == Feature_id::wall);
+        CHECK(map::cells[X0 - r][Y0 - r].rigid->id() == Feature_id::wall);
     }
 
     //Check damage to actors
-    Actor* a1 = ActorFactory::mk(ActorId::rat, Pos(X0 + 1, Y0));
-    explosion::runExplosionAt(Pos(X0, Y0), ExplType::expl);
-    CHECK_EQUAL(int(ActorState::destroyed), int(a1->getState()));
+    Actor* a1 = actor_factory::mk(Actor_id::rat, Pos(X0 + 1, Y0));
+    explosion::run_explosion_at(Pos(X0, Y0), Expl_type::expl);
+    CHECK_EQUAL(int(Actor_state::destroyed), int(a1->state()));
 
     //Check that corpses can be destroyed, and do not block living actors
     const int NR_CORPSES = 3;
@@ -459,40 +504,40 @@ TEST_FIXTURE(BasicFixture, Explosions)
 
     for (int i = 0; i < NR_CORPSES; ++i)
     {
-        corpses[i] = ActorFactory::mk(ActorId::rat, Pos(X0 + 1, Y0));
+        corpses[i] = actor_factory::mk(Actor_id::rat, Pos(X0 + 1, Y0));
         corpses[i]->die(false, false, false);
     }
 
-    a1 = ActorFactory::mk(ActorId::rat, Pos(X0 + 1, Y0));
-    explosion::runExplosionAt(Pos(X0, Y0), ExplType::expl);
+    a1 = actor_factory::mk(Actor_id::rat, Pos(X0 + 1, Y0));
+    explosion::run_explosion_at(Pos(X0, Y0), Expl_type::expl);
 
     for (int i = 0; i < NR_CORPSES; ++i)
     {
-        CHECK_EQUAL(int(ActorState::destroyed), int(corpses[i]->getState()));
+        CHECK_EQUAL(int(Actor_state::destroyed), int(corpses[i]->state()));
     }
 
-    CHECK_EQUAL(int(ActorState::destroyed), int(a1->getState()));
+    CHECK_EQUAL(int(Actor_state::destroyed), int(a1->state()));
 
     //Check explosion applying Burning to living and dead actors
-    a1        = ActorFactory::mk(ActorId::rat, Pos(X0 - 1, Y0));
-    Actor* a2 = ActorFactory::mk(ActorId::rat, Pos(X0 + 1, Y0));
+    a1        = actor_factory::mk(Actor_id::rat, Pos(X0 - 1, Y0));
+    Actor* a2 = actor_factory::mk(Actor_id::rat, Pos(X0 + 1, Y0));
 
     for (int i = 0; i < NR_CORPSES; ++i)
     {
-        corpses[i] = ActorFactory::mk(ActorId::rat, Pos(X0 + 1, Y0));
+        corpses[i] = actor_factory::mk(Actor_id::rat, Pos(X0 + 1, Y0));
         corpses[i]->die(false, false, false);
     }
 
-    explosion::runExplosionAt(Pos(X0, Y0), ExplType::applyProp,
-                              ExplSrc::misc, 0, SfxId::END,
-                              new PropBurning(PropTurns::std));
-    CHECK(a1->getPropHandler().getProp(PropId::burning, PropSrc::applied));
-    CHECK(a2->getPropHandler().getProp(PropId::burning, PropSrc::applied));
+    explosion::run_explosion_at(Pos(X0, Y0), Expl_type::apply_prop,
+                              Expl_src::misc, 0, Sfx_id::END,
+                              new Prop_burning(Prop_turns::std));
+    CHECK(a1->prop_handler().prop(Prop_id::burning, Prop_src::applied));
+    CHECK(a2->prop_handler().prop(Prop_id::burning, Prop_src::applied));
 
     for (int i = 0; i < NR_CORPSES; ++i)
     {
-        PropHandler& propHlr = corpses[i]->getPropHandler();
-        CHECK(propHlr.getProp(PropId::burning, PropSrc::applied));
+        Prop_handler& prop_hlr = corpses[i]->prop_handler();
+        CHECK(prop_hlr.prop(Prop_id::burning, Prop_src::applied));
     }
 
     //Check that the explosion can handle the map edge (e.g. that it does not
@@ -502,21 +547,21 @@ TEST_FIXTURE(BasicFixture, Explosions)
     int x = 1;
     int y = 1;
     map::put(new Floor(Pos(x, y)));
-    explosion::runExplosionAt(Pos(x, y), ExplType::expl);
-    CHECK(map::cells[x + 1][y    ].rigid->getId() != FeatureId::wall);
-    CHECK(map::cells[x    ][y + 1].rigid->getId() != FeatureId::wall);
-    CHECK(map::cells[x - 1][y    ].rigid->getId() == FeatureId::wall);
-    CHECK(map::cells[x    ][y - 1].rigid->getId() == FeatureId::wall);
+    explosion::run_explosion_at(Pos(x, y), Expl_type::expl);
+    CHECK(map::cells[x + 1][y    ].rigid->id() != Feature_id::wall);
+    CHECK(map::cells[x    ][y + 1].rigid->id() != Feature_id::wall);
+    CHECK(map::cells[x - 1][y    ].rigid->id() == Feature_id::wall);
+    CHECK(map::cells[x    ][y - 1].rigid->id() == Feature_id::wall);
 
     //South-east edge
     x = MAP_W - 2;
     y = MAP_H - 2;
     map::put(new Floor(Pos(x, y)));
-    explosion::runExplosionAt(Pos(x, y), ExplType::expl);
-    CHECK(map::cells[x - 1][y    ].rigid->getId() != FeatureId::wall);
-    CHECK(map::cells[x    ][y - 1].rigid->getId() != FeatureId::wall);
-    CHECK(map::cells[x + 1][y    ].rigid->getId() == FeatureId::wall);
-    CHECK(map::cells[x    ][y + 1].rigid->getId() == FeatureId::wall);
+    explosion::run_explosion_at(Pos(x, y), Expl_type::expl);
+    CHECK(map::cells[x - 1][y    ].rigid->id() != Feature_id::wall);
+    CHECK(map::cells[x    ][y - 1].rigid->id() != Feature_id::wall);
+    CHECK(map::cells[x + 1][y    ].rigid->id() == Feature_id::wall);
+    CHECK(map::cells[x    ][y + 1].rigid->id() == Feature_id::wall);
 }
 
 TEST_FIXTURE(BasicFixture, MonsterStuckInSpiderWeb)
@@ -528,204 +573,204 @@ TEST_FIXTURE(BasicFixture, MonsterStuckInSpiderWeb)
     // * the web can get destroyed
     //-----------------------------------------------------------------
 
-    const Pos posL(1, 4);
-    const Pos posR(2, 4);
+    const Pos pos_l(1, 4);
+    const Pos pos_r(2, 4);
 
     //Spawn left floor cell
-    map::put(new Floor(posL));
+    map::put(new Floor(pos_l));
 
     //Conditions for finished test
-    bool testedStuck              = false;
-    bool testedLooseWebIntact     = false;
-    bool testedLooseWebDestroyed  = false;
+    bool tested_stuck              = false;
+    bool tested_loose_web_intact     = false;
+    bool tested_loose_web_destroyed  = false;
 
-    while (!testedStuck || !testedLooseWebIntact || !testedLooseWebDestroyed)
+    while (!tested_stuck || !tested_loose_web_intact || !tested_loose_web_destroyed)
     {
 
         //Spawn right floor cell
-        map::put(new Floor(posR));
+        map::put(new Floor(pos_r));
 
         //Spawn a monster that can get stuck in the web
-        Actor* const actor = ActorFactory::mk(ActorId::zombie, posL);
+        Actor* const actor = actor_factory::mk(Actor_id::zombie, pos_l);
         Mon* const mon = static_cast<Mon*>(actor);
 
         //Create a spider web in the right cell
-        const auto  mimicId     = map::cells[posR.x][posR.x].rigid->getId();
-        const auto& mimicData   = FeatureData::getData(mimicId);
-        const auto* const mimic = static_cast<const Rigid*>(mimicData.mkObj(posR));
-        map::put(new Trap(posR, mimic, TrapId::web));
+        const auto  mimic_id     = map::cells[pos_r.x][pos_r.x].rigid->id();
+        const auto& mimic_data   = feature_data::data(mimic_id);
+        const auto* const mimic = static_cast<const Rigid*>(mimic_data.mk_obj(pos_r));
+        map::put(new Trap(pos_r, mimic, Trap_id::web));
 
         //Move the monster into the trap, and back again
-        mon->awareCounter_ = 20000; // > 0 req. for triggering trap
-        mon->pos = posL;
-        mon->moveDir(Dir::right);
-        CHECK(mon->pos == posR);
-        mon->moveDir(Dir::left);
-        mon->moveDir(Dir::left);
+        mon->aware_counter_ = 20000; // > 0 req. for triggering trap
+        mon->set_pos(pos_l);
+        mon->move_dir(Dir::right);
+        CHECK(mon->pos == pos_r);
+        mon->move_dir(Dir::left);
+        mon->move_dir(Dir::left);
 
         //Check conditions
-        if (mon->pos == posR)
+        if (mon->pos == pos_r)
         {
-            testedStuck = true;
+            tested_stuck = true;
         }
-        else if (mon->pos == posL)
+        else if (mon->pos == pos_l)
         {
-            const auto featureId = map::cells[posR.x][posR.y].rigid->getId();
+            const auto feature_id = map::cells[pos_r.x][pos_r.y].rigid->id();
 
-            if (featureId == FeatureId::floor)
+            if (feature_id == Feature_id::floor)
             {
-                testedLooseWebDestroyed = true;
+                tested_loose_web_destroyed = true;
             }
             else
             {
-                testedLooseWebIntact = true;
+                tested_loose_web_intact = true;
             }
         }
 
         //Remove the monster
-        ActorFactory::deleteAllMon();
+        actor_factory::delete_all_mon();
     }
 
     //Check that all cases have been triggered (not really necessary, it just
     //verifies that the loop above is correctly written).
-    CHECK(testedStuck);
-    CHECK(testedLooseWebIntact);
-    CHECK(testedLooseWebDestroyed);
+    CHECK(tested_stuck);
+    CHECK(tested_loose_web_intact);
+    CHECK(tested_loose_web_destroyed);
 }
 
 //TODO: This test shows some weakness in the inventory handling functionality. Notice how
-//onEquip() and onUnequip() has to be called manually here. This is because they
+//on_equip() and on_unequip() has to be called manually here. This is because they
 //are called from stupid places in the game code - They SHOULD be called by Inventory!
 TEST_FIXTURE(BasicFixture, InventoryHandling)
 {
     const Pos p(10, 10);
     map::put(new Floor(p));
-    map::player->pos = p;
+    map::player->set_pos(p);
 
-    Inventory&  inv       = map::player->getInv();
-    InvSlot&    bodySlot  = inv.slots_[int(SlotId::body)];
+    Inventory&  inv       = map::player->inv();
+    Inv_slot&    body_slot  = inv.slots_[int(Slot_id::body)];
 
-    delete bodySlot.item;
-    bodySlot.item = nullptr;
+    delete body_slot.item;
+    body_slot.item = nullptr;
 
-    bool props[size_t(PropId::END)];
-    PropHandler& propHandler = map::player->getPropHandler();
+    bool props[size_t(Prop_id::END)];
+    Prop_handler& prop_handler = map::player->prop_handler();
 
     //Check that no props are enabled
-    propHandler.getPropIds(props);
+    prop_handler.prop_ids(props);
 
-    for (int i = 0; i < int(PropId::END); ++i)
+    for (int i = 0; i < int(Prop_id::END); ++i)
     {
         CHECK(!props[i]);
     }
 
     //Wear asbesthos suit
-    Item* item = ItemFactory::mk(ItemId::armorAsbSuit);
-    inv.putInSlot(SlotId::body, item);
+    Item* item = item_factory::mk(Item_id::armor_asb_suit);
+    inv.put_in_slot(Slot_id::body, item);
 
-    item->onEquip(true);
+    item->on_equip(true);
 
     //Check that the props are applied
-    propHandler.getPropIds(props);
-    int nrProps = 0;
+    prop_handler.prop_ids(props);
+    int nr_props = 0;
 
-    for (int i = 0; i < int(PropId::END); ++i)
+    for (int i = 0; i < int(Prop_id::END); ++i)
     {
-        if (props[i]) {++nrProps;}
+        if (props[i]) {++nr_props;}
     }
 
-    CHECK_EQUAL(4, nrProps);
-    CHECK(props[int(PropId::rFire)]);
-    CHECK(props[int(PropId::rElec)]);
-    CHECK(props[int(PropId::rAcid)]);
-    CHECK(props[int(PropId::rBreath)]);
+    CHECK_EQUAL(4, nr_props);
+    CHECK(props[int(Prop_id::rFire)]);
+    CHECK(props[int(Prop_id::rElec)]);
+    CHECK(props[int(Prop_id::rAcid)]);
+    CHECK(props[int(Prop_id::rBreath)]);
 
     //Take off asbeshos suit
-    inv.moveToGeneral(SlotId::body);
-    item->onUnequip();
+    inv.move_to_general(Slot_id::body);
+    item->on_unequip();
     CHECK_EQUAL(item, inv.general_.back());
 
     //Check that the properties are cleared
-    propHandler.getPropIds(props);
+    prop_handler.prop_ids(props);
 
-    for (int i = 0; i < int(PropId::END); ++i)
+    for (int i = 0; i < int(Prop_id::END); ++i)
     {
         CHECK(!props[i]);
     }
 
     //Wear the asbeshos suit again
-    inv.equipGeneralItem(inv.general_.size() - 1, SlotId::body);
-    GameTime::tick();
+    inv.equip_general_item(inv.general_.size() - 1, Slot_id::body);
+    game_time::tick();
 
-    item->onEquip(true);
+    item->on_equip(true);
 
     //Check that the props are applied
-    propHandler.getPropIds(props);
-    nrProps = 0;
+    prop_handler.prop_ids(props);
+    nr_props = 0;
 
-    for (int i = 0; i < int(PropId::END); ++i)
+    for (int i = 0; i < int(Prop_id::END); ++i)
     {
-        if (props[i]) {++nrProps;}
+        if (props[i]) {++nr_props;}
     }
 
-    CHECK_EQUAL(4, nrProps);
-    CHECK(props[int(PropId::rFire)]);
-    CHECK(props[int(PropId::rElec)]);
-    CHECK(props[int(PropId::rAcid)]);
-    CHECK(props[int(PropId::rBreath)]);
+    CHECK_EQUAL(4, nr_props);
+    CHECK(props[int(Prop_id::rFire)]);
+    CHECK(props[int(Prop_id::rElec)]);
+    CHECK(props[int(Prop_id::rAcid)]);
+    CHECK(props[int(Prop_id::rBreath)]);
 
     //Drop the asbeshos suit on the ground
-    ItemDrop::tryDropItemFromInv(*map::player, InvType::slots, int(SlotId::body), 1);
+    item_drop::try_drop_item_from_inv(*map::player, Inv_type::slots, int(Slot_id::body), 1);
 
     //Check that no item exists in body slot
-    CHECK(!bodySlot.item);
+    CHECK(!body_slot.item);
 
     //Check that the item is on the ground
     Cell& cell = map::cells[p.x][p.y];
     CHECK(cell.item);
 
     //Check that the properties are cleared
-    propHandler.getPropIds(props);
+    prop_handler.prop_ids(props);
 
-    for (int i = 0; i < int(PropId::END); ++i)
+    for (int i = 0; i < int(Prop_id::END); ++i)
     {
         CHECK(!props[i]);
     }
 
     //Wear the same dropped asbesthos suit again
-    inv.putInSlot(SlotId::body, cell.item);
+    inv.put_in_slot(Slot_id::body, cell.item);
     cell.item = nullptr;
 
-    item->onEquip(true);
+    item->on_equip(true);
 
     //Check that the props are applied
-    propHandler.getPropIds(props);
-    nrProps = 0;
+    prop_handler.prop_ids(props);
+    nr_props = 0;
 
-    for (int i = 0; i < int(PropId::END); ++i)
+    for (int i = 0; i < int(Prop_id::END); ++i)
     {
-        if (props[i]) {++nrProps;}
+        if (props[i]) {++nr_props;}
     }
 
-    CHECK_EQUAL(4, nrProps);
-    CHECK(props[int(PropId::rFire)]);
-    CHECK(props[int(PropId::rElec)]);
-    CHECK(props[int(PropId::rAcid)]);
-    CHECK(props[int(PropId::rBreath)]);
+    CHECK_EQUAL(4, nr_props);
+    CHECK(props[int(Prop_id::rFire)]);
+    CHECK(props[int(Prop_id::rElec)]);
+    CHECK(props[int(Prop_id::rAcid)]);
+    CHECK(props[int(Prop_id::rBreath)]);
 }
 
 TEST_FIXTURE(BasicFixture, SavingGame)
 {
     //Item data
-    ItemData::data[int(ItemId::scrollTelep)]->isTried = true;
-    ItemData::data[int(ItemId::scrollOpening)]->isIdentified = true;
+    item_data::data[int(Item_id::scroll_telep)].is_tried = true;
+    item_data::data[int(Item_id::scroll_opening)].is_identified = true;
 
     //Bonus
-    PlayerBon::pickBg(Bg::rogue);
-    PlayerBon::traits[int(Trait::healer)] = true;
+    player_bon::pick_bg(Bg::rogue);
+    player_bon::traits[int(Trait::healer)] = true;
 
     //Player inventory
-    Inventory& inv = map::player->getInv();
+    Inventory& inv = map::player->inv();
 
     //First, remove all present items
     vector<Item*>& gen = inv.general_;
@@ -734,7 +779,7 @@ TEST_FIXTURE(BasicFixture, SavingGame)
 
     gen.clear();
 
-    for (size_t i = 0; i < size_t(SlotId::END); ++i)
+    for (size_t i = 0; i < size_t(Slot_id::END); ++i)
     {
         auto& slot = inv.slots_[i];
 
@@ -746,225 +791,225 @@ TEST_FIXTURE(BasicFixture, SavingGame)
     }
 
     //Put new items
-    Item* item = ItemFactory::mk(ItemId::miGoGun);
-    inv.putInSlot(SlotId::wielded, item);
+    Item* item = item_factory::mk(Item_id::mi_go_gun);
+    inv.put_in_slot(Slot_id::wielded, item);
 
     //Wear asbestos suit to test properties from wearing items
-    item = ItemFactory::mk(ItemId::armorAsbSuit);
-    inv.putInSlot(SlotId::body, item);
-    item = ItemFactory::mk(ItemId::pistolClip);
-    static_cast<AmmoClip*>(item)->ammo_ = 1;
-    inv.putInGeneral(item);
-    item = ItemFactory::mk(ItemId::pistolClip);
-    static_cast<AmmoClip*>(item)->ammo_ = 2;
-    inv.putInGeneral(item);
-    item = ItemFactory::mk(ItemId::pistolClip);
-    static_cast<AmmoClip*>(item)->ammo_ = 3;
-    inv.putInGeneral(item);
-    item = ItemFactory::mk(ItemId::pistolClip);
-    static_cast<AmmoClip*>(item)->ammo_ = 3;
-    inv.putInGeneral(item);
-    item = ItemFactory::mk(ItemId::deviceBlaster);
-    static_cast<StrangeDevice*>(item)->condition_ = Condition::shoddy;
-    inv.putInGeneral(item);
-    item = ItemFactory::mk(ItemId::electricLantern);
-    DeviceLantern* lantern          = static_cast<DeviceLantern*>(item);
-    lantern->nrTurnsLeft_           = 789;
-    lantern->nrFlickerTurnsLeft_    = 456;
-    lantern->workingState_          = LanternWorkingState::flicker;
-    lantern->isActivated_           = true;
-    inv.putInGeneral(item);
+    item = item_factory::mk(Item_id::armor_asb_suit);
+    inv.put_in_slot(Slot_id::body, item);
+    item = item_factory::mk(Item_id::pistol_clip);
+    static_cast<Ammo_clip*>(item)->ammo_ = 1;
+    inv.put_in_general(item);
+    item = item_factory::mk(Item_id::pistol_clip);
+    static_cast<Ammo_clip*>(item)->ammo_ = 2;
+    inv.put_in_general(item);
+    item = item_factory::mk(Item_id::pistol_clip);
+    static_cast<Ammo_clip*>(item)->ammo_ = 3;
+    inv.put_in_general(item);
+    item = item_factory::mk(Item_id::pistol_clip);
+    static_cast<Ammo_clip*>(item)->ammo_ = 3;
+    inv.put_in_general(item);
+    item = item_factory::mk(Item_id::device_blaster);
+    static_cast<Strange_device*>(item)->condition_ = Condition::shoddy;
+    inv.put_in_general(item);
+    item = item_factory::mk(Item_id::electric_lantern);
+    Device_lantern* lantern          = static_cast<Device_lantern*>(item);
+    lantern->nr_turns_left_           = 789;
+    lantern->nr_flicker_turns_left_    = 456;
+    lantern->working_state_          = Lantern_working_state::flicker;
+    lantern->is_activated_           = true;
+    inv.put_in_general(item);
 
     //Player
-    ActorDataT& def = map::player->getData();
-    def.nameA = def.nameThe = "TEST PLAYER";
-    map::player->changeMaxHp(5, false);
+    Actor_data_t& def = map::player->data();
+    def.name_a = def.name_the = "TEST PLAYER";
+    map::player->change_max_hp(5, false);
 
     //map
     map::dlvl = 7;
 
     //Actor data
-    ActorData::data[int(ActorId::END) - 1].nrKills = 123;
+    actor_data::data[int(Actor_id::END) - 1].nr_kills = 123;
 
     //Learned spells
-    PlayerSpellsHandling::learnSpellIfNotKnown(SpellId::bless);
-    PlayerSpellsHandling::learnSpellIfNotKnown(SpellId::azaWrath);
+    player_spells_handling::learn_spell_if_not_known(Spell_id::bless);
+    player_spells_handling::learn_spell_if_not_known(Spell_id::aza_wrath);
 
     //Applied properties
-    PropHandler& propHlr = map::player->getPropHandler();
-    propHlr.tryApplyProp(new PropRSleep(PropTurns::specific, 3));
-    propHlr.tryApplyProp(new PropDiseased(PropTurns::indefinite));
-    propHlr.tryApplyProp(new PropBlessed(PropTurns::std));
+    Prop_handler& prop_hlr = map::player->prop_handler();
+    prop_hlr.try_apply_prop(new Prop_rSleep(Prop_turns::specific, 3));
+    prop_hlr.try_apply_prop(new Prop_diseased(Prop_turns::indefinite));
+    prop_hlr.try_apply_prop(new Prop_blessed(Prop_turns::std));
 
     //Check a a few of the props applied
-    Prop* prop = propHlr.getProp(PropId::diseased, PropSrc::applied);
+    Prop* prop = prop_hlr.prop(Prop_id::diseased, Prop_src::applied);
     CHECK(prop);
 
-    prop = propHlr.getProp(PropId::blessed, PropSrc::applied);
+    prop = prop_hlr.prop(Prop_id::blessed, Prop_src::applied);
     CHECK(prop);
 
     //Check a prop that was NOT applied
-    prop = propHlr.getProp(PropId::confused, PropSrc::applied);
+    prop = prop_hlr.prop(Prop_id::confused, Prop_src::applied);
     CHECK(!prop);
 
     //map sequence
-    mapTravel::mapList[5] = {mapType::ratsInTheWalls,   IsMainDungeon::yes};
-    mapTravel::mapList[7] = {mapType::leng,             IsMainDungeon::no};
+    map_travel::map_list[5] = {Map_type::rats_in_the_walls,   Is_main_dungeon::yes};
+    map_travel::map_list[7] = {Map_type::leng,             Is_main_dungeon::no};
 
-    SaveHandling::save();
-    CHECK(SaveHandling::isSaveAvailable());
+    save_handling::save();
+    CHECK(save_handling::is_save_available());
 }
 
 TEST_FIXTURE(BasicFixture, LoadingGame)
 {
-    CHECK(SaveHandling::isSaveAvailable());
+    CHECK(save_handling::is_save_available());
 
-    const int PLAYER_MAX_HP_BEFORE_LOAD = map::player->getHpMax(true);
+    const int PLAYER_MAX_HP_BEFORE_LOAD = map::player->hp_max(true);
 
-    SaveHandling::load();
+    save_handling::load();
 
     //Item data
-    CHECK_EQUAL(true,  ItemData::data[int(ItemId::scrollTelep)]->isTried);
-    CHECK_EQUAL(false, ItemData::data[int(ItemId::scrollTelep)]->isIdentified);
-    CHECK_EQUAL(true,  ItemData::data[int(ItemId::scrollOpening)]->isIdentified);
-    CHECK_EQUAL(false, ItemData::data[int(ItemId::scrollOpening)]->isTried);
-    CHECK_EQUAL(false, ItemData::data[int(ItemId::scrollDetMon)]->isTried);
-    CHECK_EQUAL(false, ItemData::data[int(ItemId::scrollDetMon)]->isIdentified);
+    CHECK_EQUAL(true,  item_data::data[int(Item_id::scroll_telep)].is_tried);
+    CHECK_EQUAL(false, item_data::data[int(Item_id::scroll_telep)].is_identified);
+    CHECK_EQUAL(true,  item_data::data[int(Item_id::scroll_opening)].is_identified);
+    CHECK_EQUAL(false, item_data::data[int(Item_id::scroll_opening)].is_tried);
+    CHECK_EQUAL(false, item_data::data[int(Item_id::scroll_det_mon)].is_tried);
+    CHECK_EQUAL(false, item_data::data[int(Item_id::scroll_det_mon)].is_identified);
 
     //Bonus
-    CHECK_EQUAL(int(Bg::rogue), int(PlayerBon::getBg()));
-    CHECK(PlayerBon::traits[int(Trait::healer)]);
-    CHECK(!PlayerBon::traits[int(Trait::sharpShooter)]);
+    CHECK_EQUAL(int(Bg::rogue), int(player_bon::bg()));
+    CHECK(player_bon::traits[int(Trait::healer)]);
+    CHECK(!player_bon::traits[int(Trait::sharp_shooter)]);
 
     //Player inventory
-    Inventory& inv  = map::player->getInv();
-    auto& genInv    = inv.general_;
-    CHECK_EQUAL(6, int(genInv.size()));
-    CHECK_EQUAL(int(ItemId::miGoGun),
-                int(inv.getItemInSlot(SlotId::wielded)->getData().id));
-    CHECK_EQUAL(int(ItemId::armorAsbSuit),
-                int(inv.getItemInSlot(SlotId::body)->getData().id));
-    int nrClipWith1 = 0;
-    int nrClipWith2 = 0;
-    int nrClipWith3 = 0;
-    bool isSentryDeviceFound    = false;
-    bool isElectricLanternFound = false;
-
-    for (Item* item : genInv)
+    Inventory& inv  = map::player->inv();
+    auto& gen_inv    = inv.general_;
+    CHECK_EQUAL(6, int(gen_inv.size()));
+    CHECK_EQUAL(int(Item_id::mi_go_gun),
+                int(inv.item_in_slot(Slot_id::wielded)->data().id));
+    CHECK_EQUAL(int(Item_id::armor_asb_suit),
+                int(inv.item_in_slot(Slot_id::body)->data().id));
+    int nr_clip_with_1 = 0;
+    int nr_clip_with_2 = 0;
+    int nr_clip_with_3 = 0;
+    bool is_sentry_device_found    = false;
+    bool is_electric_lantern_found = false;
+
+    for (Item* item : gen_inv)
     {
-        ItemId id = item->getId();
+        Item_id id = item->id();
 
-        if (id == ItemId::pistolClip)
+        if (id == Item_id::pistol_clip)
         {
-            switch (static_cast<AmmoClip*>(item)->ammo_)
+            switch (static_cast<Ammo_clip*>(item)->ammo_)
             {
-            case 1: nrClipWith1++; break;
+            case 1: nr_clip_with_1++; break;
 
-            case 2: nrClipWith2++; break;
+            case 2: nr_clip_with_2++; break;
 
-            case 3: nrClipWith3++; break;
+            case 3: nr_clip_with_3++; break;
 
             default: {} break;
             }
         }
-        else if (id == ItemId::deviceBlaster)
+        else if (id == Item_id::device_blaster)
         {
-            isSentryDeviceFound = true;
+            is_sentry_device_found = true;
             CHECK_EQUAL(int(Condition::shoddy),
-                        int(static_cast<StrangeDevice*>(item)->condition_));
+                        int(static_cast<Strange_device*>(item)->condition_));
         }
-        else if (id == ItemId::electricLantern)
+        else if (id == Item_id::electric_lantern)
         {
-            isElectricLanternFound = true;
-            DeviceLantern* lantern = static_cast<DeviceLantern*>(item);
-            CHECK_EQUAL(789, lantern->nrTurnsLeft_);
-            CHECK_EQUAL(456, lantern->nrFlickerTurnsLeft_);
-            CHECK_EQUAL(int(LanternWorkingState::flicker), int(lantern->workingState_));
-            CHECK(lantern->isActivated_);
+            is_electric_lantern_found = true;
+            Device_lantern* lantern = static_cast<Device_lantern*>(item);
+            CHECK_EQUAL(789, lantern->nr_turns_left_);
+            CHECK_EQUAL(456, lantern->nr_flicker_turns_left_);
+            CHECK_EQUAL(int(Lantern_working_state::flicker), int(lantern->working_state_));
+            CHECK(lantern->is_activated_);
         }
     }
 
-    CHECK_EQUAL(1, nrClipWith1);
-    CHECK_EQUAL(1, nrClipWith2);
-    CHECK_EQUAL(2, nrClipWith3);
-    CHECK(isSentryDeviceFound);
-    CHECK(isElectricLanternFound);
+    CHECK_EQUAL(1, nr_clip_with_1);
+    CHECK_EQUAL(1, nr_clip_with_2);
+    CHECK_EQUAL(2, nr_clip_with_3);
+    CHECK(is_sentry_device_found);
+    CHECK(is_electric_lantern_found);
 
     //Player
-    ActorDataT& def = map::player->getData();
-    def.nameA = def.nameThe = "TEST PLAYER";
-    CHECK_EQUAL("TEST PLAYER", def.nameA);
-    CHECK_EQUAL("TEST PLAYER", def.nameThe);
+    Actor_data_t& def = map::player->data();
+    def.name_a = def.name_the = "TEST PLAYER";
+    CHECK_EQUAL("TEST PLAYER", def.name_a);
+    CHECK_EQUAL("TEST PLAYER", def.name_the);
     //Check max HP (affected by disease)
-    CHECK_EQUAL((PLAYER_MAX_HP_BEFORE_LOAD + 5) / 2, map::player->getHpMax(true));
+    CHECK_EQUAL((PLAYER_MAX_HP_BEFORE_LOAD + 5) / 2, map::player->hp_max(true));
 
     //map
     CHECK_EQUAL(7, map::dlvl);
 
     //Actor data
-    CHECK_EQUAL(123, ActorData::data[int(ActorId::END) - 1].nrKills);
+    CHECK_EQUAL(123, actor_data::data[int(Actor_id::END) - 1].nr_kills);
 
     //Learned spells
-    CHECK(PlayerSpellsHandling::isSpellLearned(SpellId::bless));
-    CHECK(PlayerSpellsHandling::isSpellLearned(SpellId::azaWrath));
-    CHECK_EQUAL(false, PlayerSpellsHandling::isSpellLearned(SpellId::mayhem));
+    CHECK(player_spells_handling::is_spell_learned(Spell_id::bless));
+    CHECK(player_spells_handling::is_spell_learned(Spell_id::aza_wrath));
+    CHECK_EQUAL(false, player_spells_handling::is_spell_learned(Spell_id::mayhem));
 
     //Properties
-    PropHandler& propHlr = map::player->getPropHandler();
-    Prop* prop = propHlr.getProp(PropId::diseased, PropSrc::applied);
+    Prop_handler& prop_hlr = map::player->prop_handler();
+    Prop* prop = prop_hlr.prop(Prop_id::diseased, Prop_src::applied);
     CHECK(prop);
-    CHECK_EQUAL(-1, prop->turnsLeft_);
+    CHECK_EQUAL(-1, prop->turns_left_);
     //Check currrent HP (affected by disease)
-    CHECK_EQUAL((map::player->getData().hp + 5) / 2, map::player->getHp());
+    CHECK_EQUAL((map::player->data().hp + 5) / 2, map::player->hp());
 
-    prop = propHlr.getProp(PropId::rSleep, PropSrc::applied);
+    prop = prop_hlr.prop(Prop_id::rSleep, Prop_src::applied);
     CHECK(prop);
-    CHECK_EQUAL(3, prop->turnsLeft_);
+    CHECK_EQUAL(3, prop->turns_left_);
 
-    prop = propHlr.getProp(PropId::diseased, PropSrc::applied);
+    prop = prop_hlr.prop(Prop_id::diseased, Prop_src::applied);
     CHECK(prop);
-    CHECK_EQUAL(-1, prop->turnsLeft_);
+    CHECK_EQUAL(-1, prop->turns_left_);
 
-    prop = propHlr.getProp(PropId::blessed, PropSrc::applied);
+    prop = prop_hlr.prop(Prop_id::blessed, Prop_src::applied);
     CHECK(prop);
-    CHECK(prop->turnsLeft_ > 0);
+    CHECK(prop->turns_left_ > 0);
 
     //Properties from worn item
-    prop = propHlr.getProp(PropId::rAcid, PropSrc::inv);
+    prop = prop_hlr.prop(Prop_id::rAcid, Prop_src::inv);
     CHECK(prop);
-    CHECK(prop->turnsLeft_ == -1);
-    prop = propHlr.getProp(PropId::rFire, PropSrc::inv);
+    CHECK(prop->turns_left_ == -1);
+    prop = prop_hlr.prop(Prop_id::rFire, Prop_src::inv);
     CHECK(prop);
-    CHECK(prop->turnsLeft_ == -1);
+    CHECK(prop->turns_left_ == -1);
 
     //map sequence
-    auto mapData = mapTravel::mapList[3];
-    CHECK(mapData.type          == mapType::std);
-    CHECK(mapData.isMainDungeon == IsMainDungeon::yes);
+    auto lvl_data = map_travel::map_list[3];
+    CHECK(lvl_data.type            == Map_type::std);
+    CHECK(lvl_data.is_main_dungeon == Is_main_dungeon::yes);
 
-    mapData = mapTravel::mapList[5];
-    CHECK(mapData.type          == mapType::ratsInTheWalls);
-    CHECK(mapData.isMainDungeon == IsMainDungeon::yes);
+    lvl_data = map_travel::map_list[5];
+    CHECK(lvl_data.type            == Map_type::rats_in_the_walls);
+    CHECK(lvl_data.is_main_dungeon == Is_main_dungeon::yes);
 
-    mapData = mapTravel::mapList[7];
-    CHECK(mapData.type          == mapType::leng);
-    CHECK(mapData.isMainDungeon == IsMainDungeon::no);
+    lvl_data = map_travel::map_list[7];
+    CHECK(lvl_data.type            == Map_type::leng);
+    CHECK(lvl_data.is_main_dungeon == Is_main_dungeon::no);
 
     //Game time
-    CHECK_EQUAL(0, GameTime::getTurn());
+    CHECK_EQUAL(0, game_time::turn());
 }
 
 TEST_FIXTURE(BasicFixture, FloodFilling)
 {
     bool b[MAP_W][MAP_H];
-    utils::resetArray(b, false);
+    utils::reset_array(b, false);
 
     for (int y = 0; y < MAP_H; ++y) {b[0][y] = b[MAP_W - 1][y] = false;}
 
     for (int x = 0; x < MAP_W; ++x) {b[x][0] = b[x][MAP_H - 1] = false;}
 
     int flood[MAP_W][MAP_H];
-    FloodFill::run(Pos(20, 10), b, flood, 999, Pos(-1, -1), true);
+    flood_fill::run(Pos(20, 10), b, flood, 999, Pos(-1, -1), true);
     CHECK_EQUAL(0, flood[20][10]);
     CHECK_EQUAL(1, flood[19][10]);
     CHECK_EQUAL(1, flood[21][10]);
@@ -981,13 +1026,13 @@ TEST_FIXTURE(BasicFixture, PathFinding)
 {
     vector<Pos> path;
     bool b[MAP_W][MAP_H];
-    utils::resetArray(b, false);
+    utils::reset_array(b, false);
 
     for (int y = 0; y < MAP_H; ++y) {b[0][y] = b[MAP_W - 1][y] = false;}
 
     for (int x = 0; x < MAP_W; ++x) {b[x][0] = b[x][MAP_H - 1] = false;}
 
-    PathFind::run(Pos(20, 10), Pos(25, 10), b, path);
+    path_find::run(Pos(20, 10), Pos(25, 10), b, path);
 
     CHECK(!path.empty());
     CHECK(path.back() != Pos(20, 10));
@@ -995,7 +1040,7 @@ TEST_FIXTURE(BasicFixture, PathFinding)
     CHECK_EQUAL(10, path.front().y);
     CHECK_EQUAL(5, int(path.size()));
 
-    PathFind::run(Pos(20, 10), Pos(5, 3), b, path);
+    path_find::run(Pos(20, 10), Pos(5, 3), b, path);
 
     CHECK(!path.empty());
     CHECK(path.back() != Pos(20, 10));
@@ -1005,7 +1050,7 @@ TEST_FIXTURE(BasicFixture, PathFinding)
 
     b[10][5] = true;
 
-    PathFind::run(Pos(7, 5), Pos(20, 5), b, path);
+    path_find::run(Pos(7, 5), Pos(20, 5), b, path);
 
     CHECK(!path.empty());
     CHECK(path.back() != Pos(7, 5));
@@ -1016,7 +1061,7 @@ TEST_FIXTURE(BasicFixture, PathFinding)
 
     b[19][4] = b[19][5] =  b[19][6] = true;
 
-    PathFind::run(Pos(7, 5), Pos(20, 5), b, path);
+    path_find::run(Pos(7, 5), Pos(20, 5), b, path);
 
     CHECK(!path.empty());
     CHECK(path.back() != Pos(7, 5));
@@ -1027,7 +1072,7 @@ TEST_FIXTURE(BasicFixture, PathFinding)
     CHECK(find(begin(path), end(path), Pos(19, 5)) == end(path));
     CHECK(find(begin(path), end(path), Pos(19, 6)) == end(path));
 
-    PathFind::run(Pos(40, 10), Pos(43, 15), b, path, false);
+    path_find::run(Pos(40, 10), Pos(43, 15), b, path, false);
 
     CHECK(!path.empty());
     CHECK(path.back() != Pos(40, 10));
@@ -1037,7 +1082,7 @@ TEST_FIXTURE(BasicFixture, PathFinding)
 
     b[41][10] = b[40][11]  = true;
 
-    PathFind::run(Pos(40, 10), Pos(43, 15), b, path, false);
+    path_find::run(Pos(40, 10), Pos(43, 15), b, path, false);
 
     CHECK(!path.empty());
     CHECK(path.back() != Pos(40, 10));
@@ -1046,15 +1091,15 @@ TEST_FIXTURE(BasicFixture, PathFinding)
     CHECK_EQUAL(10, int(path.size()));
 }
 
-TEST_FIXTURE(BasicFixture, mapParseExpandOne)
+TEST_FIXTURE(BasicFixture, MapParseExpandOne)
 {
     bool in[MAP_W][MAP_H];
-    utils::resetArray(in, false);
+    utils::reset_array(in, false);
 
     in[10][5] = true;
 
     bool out[MAP_W][MAP_H];
-    mapParse::expand(in, out);
+    map_parse::expand(in, out);
 
     CHECK(!out[8][5]);
     CHECK(out[9][5]);
@@ -1069,7 +1114,7 @@ TEST_FIXTURE(BasicFixture, mapParseExpandOne)
     CHECK(!out[12][4]);
 
     in[14][5] = true;
-    mapParse::expand(in, out);
+    map_parse::expand(in, out);
 
     CHECK(out[10][5]);
     CHECK(out[11][5]);
@@ -1078,15 +1123,15 @@ TEST_FIXTURE(BasicFixture, mapParseExpandOne)
     CHECK(out[14][5]);
 
     in[12][5] = true;
-    mapParse::expand(in, out);
+    map_parse::expand(in, out);
     CHECK(out[12][4]);
     CHECK(out[12][5]);
     CHECK(out[12][6]);
 
     //Check that old values are cleared
-    utils::resetArray(in, false);
+    utils::reset_array(in, false);
     in[40][10] = true;
-    mapParse::expand(in, out);
+    map_parse::expand(in, out);
     CHECK(out[39][10]);
     CHECK(out[40][10]);
     CHECK(out[41][10]);
@@ -1098,109 +1143,109 @@ TEST_FIXTURE(BasicFixture, mapParseExpandOne)
 TEST_FIXTURE(BasicFixture, FindRoomCorrEntries)
 {
     //------------------------------------------------ Square, normal sized room
-    Rect roomRect(20, 5, 30, 10);
+    Rect room_rect(20, 5, 30, 10);
 
-    Room* room = RoomFactory::mk(RoomType::plain, roomRect);
+    Room* room = room_factory::mk(Room_type::plain, room_rect);
 
-    for (int y = roomRect.p0.y; y <= roomRect.p1.y; ++y)
+    for (int y = room_rect.p0.y; y <= room_rect.p1.y; ++y)
     {
-        for (int x = roomRect.p0.x; x <= roomRect.p1.x; ++x)
+        for (int x = room_rect.p0.x; x <= room_rect.p1.x; ++x)
         {
             map::put(new Floor(Pos(x, y)));
-            map::roommap[x][y] = room;
+            map::room_map[x][y] = room;
         }
     }
 
-    vector<Pos> entryList;
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    bool entrymap[MAP_W][MAP_H];
-    utils::mkBoolmapFromVector(entryList, entrymap);
-
-    CHECK(!entrymap[19][4]);
-    CHECK(entrymap[19][5]);
-    CHECK(entrymap[20][4]);
-    CHECK(!entrymap[20][5]);
-    CHECK(entrymap[21][4]);
-    CHECK(entrymap[25][4]);
-    CHECK(!entrymap[25][8]);
-    CHECK(entrymap[29][4]);
-    CHECK(entrymap[30][4]);
-    CHECK(!entrymap[31][4]);
+    vector<Pos> entry_list;
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    bool entry_map[MAP_W][MAP_H];
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
+
+    CHECK(!entry_map[19][4]);
+    CHECK(entry_map[19][5]);
+    CHECK(entry_map[20][4]);
+    CHECK(!entry_map[20][5]);
+    CHECK(entry_map[21][4]);
+    CHECK(entry_map[25][4]);
+    CHECK(!entry_map[25][8]);
+    CHECK(entry_map[29][4]);
+    CHECK(entry_map[30][4]);
+    CHECK(!entry_map[31][4]);
 
     //Check that a cell in the middle of the room is not an entry, even if it's not
     //belonging to the room
-    map::roommap[25][7] = nullptr;
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
+    map::room_map[25][7] = nullptr;
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
 
-    CHECK(!entrymap[25][7]);
+    CHECK(!entry_map[25][7]);
 
     //The cell should also not be an entry if it's a wall and belonging to the room
-    map::roommap[25][7] = room;
+    map::room_map[25][7] = room;
     map::put(new Wall(Pos(25, 7)));
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
 
-    CHECK(!entrymap[25][7]);
+    CHECK(!entry_map[25][7]);
 
     //The cell should also not be an entry if it's a wall and not belonging to the room
-    map::roommap[25][7] = nullptr;
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
+    map::room_map[25][7] = nullptr;
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
 
-    CHECK(!entrymap[25][7]);
+    CHECK(!entry_map[25][7]);
 
     //Check that the room can share an antry point with a nearby room
-    roomRect = Rect(10, 5, 18, 10);
+    room_rect = Rect(10, 5, 18, 10);
 
-    Room* nearbyRoom = RoomFactory::mk(RoomType::plain, roomRect);
+    Room* nearby_room = room_factory::mk(Room_type::plain, room_rect);
 
-    for (int y = roomRect.p0.y; y <= roomRect.p1.y; ++y)
+    for (int y = room_rect.p0.y; y <= room_rect.p1.y; ++y)
     {
-        for (int x = roomRect.p0.x; x <= roomRect.p1.x; ++x)
+        for (int x = room_rect.p0.x; x <= room_rect.p1.x; ++x)
         {
             map::put(new Floor(Pos(x, y)));
-            map::roommap[x][y] = nearbyRoom;
+            map::room_map[x][y] = nearby_room;
         }
     }
 
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
 
-    vector<Pos> entryListNearbyRoom;
-    mapGenutils::getValidRoomCorrEntries(*nearbyRoom, entryListNearbyRoom);
-    bool entrymapNearbyRoom[MAP_W][MAP_H];
-    utils::mkBoolmapFromVector(entryListNearbyRoom, entrymapNearbyRoom);
+    vector<Pos> entry_list_nearby_room;
+    map_gen_utils::valid_room_corr_entries(*nearby_room, entry_list_nearby_room);
+    bool entry_map_nearby_room[MAP_W][MAP_H];
+    utils::mk_bool_map_from_vector(entry_list_nearby_room, entry_map_nearby_room);
 
     for (int y = 5; y <= 10; ++y)
     {
-        CHECK(entrymap[19][y]);
-        CHECK(entrymapNearbyRoom[19][y]);
+        CHECK(entry_map[19][y]);
+        CHECK(entry_map_nearby_room[19][y]);
     }
 
-    delete nearbyRoom;
+    delete nearby_room;
 
     //------------------------------------------------ Room with only one cell
     delete room;
-    room = RoomFactory::mk(RoomType::plain, {60, 10, 60, 10});
+    room = room_factory::mk(Room_type::plain, {60, 10, 60, 10});
     map::put(new Floor(Pos(60, 10)));
-    map::roommap[60][10] = room;
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
+    map::room_map[60][10] = room;
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
 
     // 59 60 61
     // #  #  # 9
     // #  .  # 10
     // #  #  # 11
-    CHECK(!entrymap[59][9]);
-    CHECK(entrymap[60][9]);
-    CHECK(!entrymap[61][9]);
-    CHECK(entrymap[59][10]);
-    CHECK(!entrymap[60][10]);
-    CHECK(entrymap[61][10]);
-    CHECK(!entrymap[59][11]);
-    CHECK(entrymap[60][11]);
-    CHECK(!entrymap[61][11]);
+    CHECK(!entry_map[59][9]);
+    CHECK(entry_map[60][9]);
+    CHECK(!entry_map[61][9]);
+    CHECK(entry_map[59][10]);
+    CHECK(!entry_map[60][10]);
+    CHECK(entry_map[61][10]);
+    CHECK(!entry_map[59][11]);
+    CHECK(entry_map[60][11]);
+    CHECK(!entry_map[61][11]);
 
     //Add an adjacent floor above the room
     // 59 60 61
@@ -1208,36 +1253,36 @@ TEST_FIXTURE(BasicFixture, FindRoomCorrEntries)
     // #  .  # 10
     // #  #  # 11
     map::put(new Floor(Pos(60, 9)));
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
-
-    CHECK(!entrymap[59][9]);
-    CHECK(!entrymap[60][9]);
-    CHECK(!entrymap[61][9]);
-    CHECK(entrymap[59][10]);
-    CHECK(!entrymap[60][10]);
-    CHECK(entrymap[61][10]);
-    CHECK(!entrymap[59][11]);
-    CHECK(entrymap[60][11]);
-    CHECK(!entrymap[61][11]);
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
+
+    CHECK(!entry_map[59][9]);
+    CHECK(!entry_map[60][9]);
+    CHECK(!entry_map[61][9]);
+    CHECK(entry_map[59][10]);
+    CHECK(!entry_map[60][10]);
+    CHECK(entry_map[61][10]);
+    CHECK(!entry_map[59][11]);
+    CHECK(entry_map[60][11]);
+    CHECK(!entry_map[61][11]);
 
     //Mark the adjacent floor as a room and check again
-    Room* adjRoom = RoomFactory::mk(RoomType::plain, {60, 9, 60, 9});
-    map::roommap[60][9] = adjRoom;
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
-
-    delete adjRoom;
-
-    CHECK(!entrymap[59][9]);
-    CHECK(!entrymap[60][9]);
-    CHECK(!entrymap[61][9]);
-    CHECK(entrymap[59][10]);
-    CHECK(!entrymap[60][10]);
-    CHECK(entrymap[61][10]);
-    CHECK(!entrymap[59][11]);
-    CHECK(entrymap[60][11]);
-    CHECK(!entrymap[61][11]);
+    Room* adj_room = room_factory::mk(Room_type::plain, {60, 9, 60, 9});
+    map::room_map[60][9] = adj_room;
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
+
+    delete adj_room;
+
+    CHECK(!entry_map[59][9]);
+    CHECK(!entry_map[60][9]);
+    CHECK(!entry_map[61][9]);
+    CHECK(entry_map[59][10]);
+    CHECK(!entry_map[60][10]);
+    CHECK(entry_map[61][10]);
+    CHECK(!entry_map[59][11]);
+    CHECK(entry_map[60][11]);
+    CHECK(!entry_map[61][11]);
 
     //Make the room wider, entries should not be placed next to adjacent floor
     // 58 59 60 61
@@ -1246,22 +1291,22 @@ TEST_FIXTURE(BasicFixture, FindRoomCorrEntries)
     // #  #  #  # 11
     room->r_.p0.x = 59;
     map::put(new Floor(Pos(59, 10)));
-    map::roommap[59][10] = room;
-    mapGenutils::getValidRoomCorrEntries(*room, entryList);
-    utils::mkBoolmapFromVector(entryList, entrymap);
-
-    CHECK(!entrymap[58][9]);
-    CHECK(entrymap[59][9]);
-    CHECK(!entrymap[60][9]);
-    CHECK(!entrymap[61][9]);
-    CHECK(entrymap[58][10]);
-    CHECK(!entrymap[59][10]);
-    CHECK(!entrymap[60][10]);
-    CHECK(entrymap[61][10]);
-    CHECK(!entrymap[58][11]);
-    CHECK(entrymap[59][11]);
-    CHECK(entrymap[60][11]);
-    CHECK(!entrymap[61][11]);
+    map::room_map[59][10] = room;
+    map_gen_utils::valid_room_corr_entries(*room, entry_list);
+    utils::mk_bool_map_from_vector(entry_list, entry_map);
+
+    CHECK(!entry_map[58][9]);
+    CHECK(entry_map[59][9]);
+    CHECK(!entry_map[60][9]);
+    CHECK(!entry_map[61][9]);
+    CHECK(entry_map[58][10]);
+    CHECK(!entry_map[59][10]);
+    CHECK(!entry_map[60][10]);
+    CHECK(entry_map[61][10]);
+    CHECK(!entry_map[58][11]);
+    CHECK(entry_map[59][11]);
+    CHECK(entry_map[60][11]);
+    CHECK(!entry_map[61][11]);
 
     //Remove the adjacent room, and check that the blocked entries are now placed
     //TODO
@@ -1271,52 +1316,52 @@ TEST_FIXTURE(BasicFixture, FindRoomCorrEntries)
 
 TEST_FIXTURE(BasicFixture, ConnectRoomsWithCorridor)
 {
-    Rect roomArea1(Pos(1, 1), Pos(10, 10));
-    Rect roomArea2(Pos(15, 4), Pos(23, 14));
+    Rect room_area1(Pos(1, 1), Pos(10, 10));
+    Rect room_area2(Pos(15, 4), Pos(23, 14));
 
-    Room* room0 = RoomFactory::mk(RoomType::plain, roomArea1);
-    Room* room1 = RoomFactory::mk(RoomType::plain, roomArea2);
+    Room* room0 = room_factory::mk(Room_type::plain, room_area1);
+    Room* room1 = room_factory::mk(Room_type::plain, room_area2);
 
-    for (int y = roomArea1.p0.y; y <= roomArea1.p1.y; ++y)
+    for (int y = room_area1.p0.y; y <= room_area1.p1.y; ++y)
     {
-        for (int x = roomArea1.p0.x; x <= roomArea1.p1.x; ++x)
+        for (int x = room_area1.p0.x; x <= room_area1.p1.x; ++x)
         {
             map::put(new Floor(Pos(x, y)));
-            map::roommap[x][y] = room0;
+            map::room_map[x][y] = room0;
         }
     }
 
-    for (int y = roomArea2.p0.y; y <= roomArea2.p1.y; ++y)
+    for (int y = room_area2.p0.y; y <= room_area2.p1.y; ++y)
     {
-        for (int x = roomArea2.p0.x; x <= roomArea2.p1.x; ++x)
+        for (int x = room_area2.p0.x; x <= room_area2.p1.x; ++x)
         {
             map::put(new Floor(Pos(x, y)));
-            map::roommap[x][y] = room1;
+            map::room_map[x][y] = room1;
         }
     }
 
-    mapGenutils::mkPathFindCor(*room0, *room1);
+    map_gen_utils::mk_path_find_cor(*room0, *room1);
 
     int flood[MAP_W][MAP_H];
     bool blocked[MAP_W][MAP_H];
-    mapParse::run(CellCheck::BlocksMoveCmn(false), blocked);
-    FloodFill::run(5, blocked, flood, INT_MAX, -1, true);
+    map_parse::run(cell_check::Blocks_move_cmn(false), blocked);
+    flood_fill::run(5, blocked, flood, INT_MAX, -1, true);
     CHECK(flood[20][10] > 0);
 
     delete room0;
     delete room1;
 }
 
-TEST_FIXTURE(BasicFixture, mapParseGetCellsWithinDistOfOthers)
+TEST_FIXTURE(BasicFixture, MapParseGetCellsWithinDistOfOthers)
 {
     bool in[MAP_W][MAP_H];
     bool out[MAP_W][MAP_H];
 
-    utils::resetArray(in, false);  //Make sure all values are 0
+    utils::reset_array(in, false);  //Make sure all values are 0
 
     in[20][10] = true;
 
-    mapParse::getCellsWithinDistOfOthers(in, out, Range(0, 1));
+    map_parse::cells_within_dist_of_others(in, out, Range(0, 1));
     CHECK_EQUAL(false, out[18][10]);
     CHECK_EQUAL(true,  out[19][10]);
     CHECK_EQUAL(false, out[20][ 8]);
@@ -1325,12 +1370,12 @@ TEST_FIXTURE(BasicFixture, mapParseGetCellsWithinDistOfOthers)
     CHECK_EQUAL(true,  out[20][11]);
     CHECK_EQUAL(true,  out[21][11]);
 
-    mapParse::getCellsWithinDistOfOthers(in, out, Range(1, 1));
+    map_parse::cells_within_dist_of_others(in, out, Range(1, 1));
     CHECK_EQUAL(true,  out[19][10]);
     CHECK_EQUAL(false, out[20][10]);
     CHECK_EQUAL(true,  out[21][11]);
 
-    mapParse::getCellsWithinDistOfOthers(in, out, Range(1, 5));
+    map_parse::cells_within_dist_of_others(in, out, Range(1, 5));
     CHECK_EQUAL(true,  out[23][10]);
     CHECK_EQUAL(true,  out[24][10]);
     CHECK_EQUAL(true,  out[25][10]);
@@ -1345,7 +1390,7 @@ TEST_FIXTURE(BasicFixture, mapParseGetCellsWithinDistOfOthers)
 
     in[23][10] = true;
 
-    mapParse::getCellsWithinDistOfOthers(in, out, Range(1, 1));
+    map_parse::cells_within_dist_of_others(in, out, Range(1, 1));
     CHECK_EQUAL(false, out[18][10]);
     CHECK_EQUAL(true,  out[19][10]);
     CHECK_EQUAL(false, out[20][10]);
@@ -1356,6 +1401,978 @@ TEST_FIXTURE(BasicFixture, mapParseGetCellsWithinDistOfOthers)
     CHECK_EQUAL(false, out[25][10]);
 }
 
+
+TEST(MapParseDistFieldMatchesBruteForce)
+{
+    //The distance field based functions must give exactly the same results as the
+    //straightforward implementations below (which scan a square/ring around each cell)
+    auto expand_ref = [](const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H],
+                         const int DIST)
+    {
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                out[x][y] = false;
+
+                for (int cmp_x = max(0, x - DIST); cmp_x <= min(MAP_W - 1, x + DIST); ++cmp_x)
+                {
+                    for (int cmp_y = max(0, y - DIST); cmp_y <= min(MAP_H - 1, y + DIST); ++cmp_y)
+                    {
+                        if (in[cmp_x][cmp_y]) {out[x][y] = true;}
+                    }
+                }
+            }
+        }
+    };
+
+    auto within_dist_ref = [](const bool in[MAP_W][MAP_H], bool out[MAP_W][MAP_H],
+                              const Range& dist_interval)
+    {
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                out[x][y] = false;
+
+                for (int d = dist_interval.lower; d <= dist_interval.upper; ++d)
+                {
+                    const Pos p0(max(0, x - d), max(0, y - d));
+                    const Pos p1(min(MAP_W - 1, x + d), min(MAP_H - 1, y + d));
+
+                    for (int cmp_x = p0.x; cmp_x <= p1.x; ++cmp_x)
+                    {
+                        if (in[cmp_x][p0.y] || in[cmp_x][p1.y]) {out[x][y] = true;}
+                    }
+
+                    for (int cmp_y = p0.y; cmp_y <= p1.y; ++cmp_y)
+                    {
+                        if (in[p0.x][cmp_y] || in[p1.x][cmp_y]) {out[x][y] = true;}
+                    }
+                }
+            }
+        }
+    };
+
+    bool in[MAP_W][MAP_H];
+    bool out[MAP_W][MAP_H];
+    bool expected[MAP_W][MAP_H];
+
+    for (int i = 0; i < 12; ++i)
+    {
+        const int ONE_IN_N = i % 2 == 0 ? 20 : 300;
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                in[x][y] = rnd::one_in(ONE_IN_N);
+            }
+        }
+
+        const int DIST = rnd::range(0, 6);
+
+        map_parse::expand(in, out, DIST);
+        expand_ref(in, expected, DIST);
+
+        const Range dist_interval(rnd::range(0, 4), rnd::range(0, 8));
+
+        bool is_equal = true;
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (out[x][y] != expected[x][y]) {is_equal = false;}
+            }
+        }
+
+        map_parse::cells_within_dist_of_others(in, out, dist_interval);
+        within_dist_ref(in, expected, dist_interval);
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (out[x][y] != expected[x][y]) {is_equal = false;}
+            }
+        }
+
+        CHECK(is_equal);
+    }
+}
+
+TEST(FloodFillMatchesReference)
+{
+    //Plain breadth first search, for comparing with the flood fill
+    auto flood_ref = [](const Pos& p0, const bool blocked[MAP_W][MAP_H],
+                        int out[MAP_W][MAP_H], const int TRAVEL_LMT,
+                        const bool ALLOW_DIAGONAL)
+    {
+        utils::reset_array(out);
+
+        const vector<Pos>& dirs = ALLOW_DIAGONAL ?
+                                  dir_utils::dir_list : dir_utils::cardinal_list;
+
+        vector<Pos> queue {p0};
+
+        for (size_t i = 0; i < queue.size(); ++i)
+        {
+            const Pos cur_pos = queue[i];
+
+            if (out[cur_pos.x][cur_pos.y] >= TRAVEL_LMT) {break;}
+
+            for (const Pos& d : dirs)
+            {
+                const Pos p(cur_pos + d);
+
+                if (
+                    utils::is_pos_inside_map(p, false) &&
+                    !blocked[p.x][p.y] && out[p.x][p.y] == 0 && p != p0)
+                {
+                    out[p.x][p.y] = out[cur_pos.x][cur_pos.y] + 1;
+                    queue.push_back(p);
+                }
+            }
+        }
+    };
+
+    bool blocked[MAP_W][MAP_H];
+
+    int flood[MAP_W][MAP_H];
+    int expected[MAP_W][MAP_H];
+
+    for (int i = 0; i < 20; ++i)
+    {
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                blocked[x][y] = rnd::one_in(4);
+            }
+        }
+
+        const bool  ALLOW_DIAGONAL  = i % 2 == 0;
+        const int   TRAVEL_LMT      = i % 3 == 0 ? rnd::range(1, 10) : INT_MAX;
+
+        vector<Pos> origins;
+
+        for (int j = 0; j < 3; ++j)
+        {
+            origins.push_back(Pos(rnd::range(1, MAP_W - 2), rnd::range(1, MAP_H - 2)));
+        }
+
+        //Single origin
+        flood_fill::run(origins[0], blocked, flood, TRAVEL_LMT, Pos(-1, -1),
+                        ALLOW_DIAGONAL);
+
+        flood_ref(origins[0], blocked, expected, TRAVEL_LMT, ALLOW_DIAGONAL);
+
+        bool is_equal = true;
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (flood[x][y] != expected[x][y]) {is_equal = false;}
+            }
+        }
+
+        CHECK(is_equal);
+
+        //Several origins - each cell should get the distance to the nearest origin
+        flood_fill::run(origins, blocked, flood, TRAVEL_LMT, Pos(-1, -1), ALLOW_DIAGONAL);
+
+        int nearest[MAP_W][MAP_H];
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                nearest[x][y] = INT_MAX;
+            }
+        }
+
+        for (const Pos& origin : origins)
+        {
+            flood_ref(origin, blocked, expected, TRAVEL_LMT, ALLOW_DIAGONAL);
+
+            for (int x = 0; x < MAP_W; ++x)
+            {
+                for (int y = 0; y < MAP_H; ++y)
+                {
+                    const bool IS_REACHED = expected[x][y] != 0 || Pos(x, y) == origin;
+
+                    if (IS_REACHED) {nearest[x][y] = min(nearest[x][y], expected[x][y]);}
+                }
+            }
+        }
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                const int EXPECTED = nearest[x][y] == INT_MAX ? 0 : nearest[x][y];
+
+                if (flood[x][y] != EXPECTED) {is_equal = false;}
+            }
+        }
+
+        CHECK(is_equal);
+    }
+}
+
+TEST_FIXTURE(BasicFixture, PathFindingMatchesFloodFill)
+{
+    //The path finder must give exactly the same paths as walking back along a flood
+    //fill from the origin (which is how paths were found before), also when choosing
+    //steps at random (given the same random seed)
+    auto path_ref = [](const Pos& p0, const Pos& p1, bool blocked[MAP_W][MAP_H],
+                       vector<Pos>& out, const bool ALLOW_DIAGONAL,
+                       const bool RANDOMIZE_STEP_CHOICES)
+    {
+        out.clear();
+
+        if (p0 == p1) {return;}
+
+        int flood[MAP_W][MAP_H];
+        flood_fill::run(p0, blocked, flood, 10000, p1, ALLOW_DIAGONAL);
+
+        if (flood[p1.x][p1.y] == 0) {return;}
+
+        const vector<Pos>& dirs = ALLOW_DIAGONAL ?
+                                  dir_utils::dir_list : dir_utils::cardinal_list;
+
+        Pos cur_pos(p1);
+        out.push_back(cur_pos);
+
+        while (true)
+        {
+            vector<Pos> valid;
+
+            for (const Pos& d : dirs)
+            {
+                const Pos adj_pos(cur_pos + d);
+
+                if (adj_pos == p0) {return;}
+
+                const int VAL_AT_ADJ = utils::is_pos_inside_map(adj_pos) ?
+                                       flood[adj_pos.x][adj_pos.y] : 0;
+
+                if (VAL_AT_ADJ < flood[cur_pos.x][cur_pos.y] && VAL_AT_ADJ != 0)
+                {
+                    valid.push_back(adj_pos);
+                }
+            }
+
+            cur_pos = RANDOMIZE_STEP_CHOICES ? valid[rnd::range(0, valid.size() - 1)] :
+                      valid[0];
+
+            out.push_back(cur_pos);
+        }
+    };
+
+    vector<Pos> path;
+    vector<Pos> path_expected;
+
+    int nr_paths_found = 0;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        map::dlvl = 1 + i * 5;
+
+        while (!map_gen::mk_std_lvl()) {}
+
+        bool blocked[MAP_W][MAP_H];
+        map_parse::run(cell_check::Blocks_move_cmn(false), blocked);
+
+        vector<Pos> free_cells;
+        utils::mk_vector_from_bool_map(false, blocked, free_cells);
+
+        for (int j = 0; j < 500; ++j)
+        {
+            const Pos& p0 = free_cells[rnd::range(0, free_cells.size() - 1)];
+
+            //Mostly short paths (like monsters moving towards the player)
+            const Pos p1 = j % 4 == 0 ? free_cells[rnd::range(0, free_cells.size() - 1)] :
+                           p0 + Pos(rnd::range(-3, 3), rnd::range(-3, 3));
+
+            if (!utils::is_pos_inside_map(p1)) {continue;}
+
+            const bool ALLOW_DIAGONAL           = j % 3 != 0;
+            const bool RANDOMIZE_STEP_CHOICES   = j % 2 == 0;
+
+            const unsigned long SEED = j + 1;
+
+            rnd::seed(SEED);
+
+            path_ref(p0, p1, blocked, path_expected, ALLOW_DIAGONAL, RANDOMIZE_STEP_CHOICES);
+
+            rnd::seed(SEED);
+
+            path_find::run(p0, p1, blocked, path, ALLOW_DIAGONAL, RANDOMIZE_STEP_CHOICES);
+
+            CHECK(path == path_expected);
+
+            if (!path.empty()) {++nr_paths_found;}
+        }
+    }
+
+    CHECK(nr_paths_found > 0);
+}
+
+TEST_FIXTURE(BasicFixture, FovAlgorithmsCompared)
+{
+    //Runs both FOV algorithms from every free cell on a few generated maps, and
+    //counts how many cells they disagree on. The algorithms are not expected to
+    //agree on every cell (they resolve corners and diagonal gaps differently), but
+    //they should never differ significantly.
+    int nr_cells_compared   = 0;
+    int nr_cells_differing  = 0;
+
+    bool blocked[MAP_W][MAP_H];
+    bool fov_ray[MAP_W][MAP_H];
+    bool fov_shadow_cast[MAP_W][MAP_H];
+
+    for (int i = 0; i < 5; ++i)
+    {
+        map::dlvl = 1 + i * 5;
+
+        while (!map_gen::mk_std_lvl()) {}
+
+        map_parse::run(cell_check::Blocks_los(), blocked);
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (blocked[x][y])
+                {
+                    continue;
+                }
+
+                const Pos origin(x, y);
+
+                for (int is_affected_by_drk = 0; is_affected_by_drk <= 1;
+                     ++is_affected_by_drk)
+                {
+                    fov::run_fov_on_array(blocked, origin, fov_ray, is_affected_by_drk,
+                                          Fov_algo::ray);
+
+                    fov::run_fov_on_array(blocked, origin, fov_shadow_cast,
+                                          is_affected_by_drk, Fov_algo::shadow_cast);
+
+                    //The origin is always seen
+                    CHECK(fov_shadow_cast[x][y]);
+
+                    for (int fov_x = 0; fov_x < MAP_W; ++fov_x)
+                    {
+                        for (int fov_y = 0; fov_y < MAP_H; ++fov_y)
+                        {
+                            //Walls are not compared, since the ray algorithm often
+                            //misses walls at corners, which shadow casting reveals
+                            const bool IS_COMPARED =
+                                !blocked[fov_x][fov_y] &&
+                                (fov_ray[fov_x][fov_y] || fov_shadow_cast[fov_x][fov_y]);
+
+                            if (IS_COMPARED)
+                            {
+                                ++nr_cells_compared;
+
+                                if (fov_ray[fov_x][fov_y] != fov_shadow_cast[fov_x][fov_y])
+                                {
+                                    ++nr_cells_differing;
+                                }
+                            }
+
+                            //Nothing outside the FOV radius is ever seen
+                            if (utils::king_dist(origin, Pos(fov_x, fov_y)) >
+                                FOV_STD_RADI_INT)
+                            {
+                                CHECK(!fov_shadow_cast[fov_x][fov_y]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    CHECK(nr_cells_compared > 0);
+    CHECK(nr_cells_differing * 100 < nr_cells_compared);
+}
+
+//Evaluates a cell check on each cell, mob and actor separately (without reading the
+//obstruction layers), to compare the map parser against
+template<typename Check_t>
+void map_parse_ref(const Check_t& check, bool out[MAP_W][MAP_H])
+{
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (check.is_checking_cells()) {out[x][y] = check.check(map::cells[x][y]);}
+        }
+    }
+
+    if (check.is_checking_mobs())
+    {
+        for (const Mob* const mob : game_time::mobs_)
+        {
+            const Pos& p = mob->pos();
+
+            if (check.check(*mob)) {out[p.x][p.y] = true;}
+        }
+    }
+
+    if (check.is_checking_actors())
+    {
+        for (const Actor* const actor : game_time::actors_)
+        {
+            const Pos& p = actor->pos;
+
+            if (check.check(*actor)) {out[p.x][p.y] = true;}
+        }
+    }
+}
+
+template<typename Check_t>
+bool is_map_parse_equal_to_ref(const Check_t& check)
+{
+    //Checks which only evaluate actors leave the other cells as they were
+    bool out[MAP_W][MAP_H]      = {};
+    bool out_ref[MAP_W][MAP_H]  = {};
+
+    map_parse::run(check, out);
+    map_parse_ref(check, out_ref);
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (out[x][y] != out_ref[x][y]) {return false;}
+        }
+    }
+    return true;
+}
+
+TEST_FIXTURE(BasicFixture, MapParseMatchesCellByCellChecks)
+{
+    //The map parser must give the same result as evaluating the checks cell by cell,
+    //also for the checks which read an obstruction layer instead
+    for (int i = 0; i < 3; ++i)
+    {
+        map::dlvl = 1 + i * 5;
+
+        while (!map_gen::mk_std_lvl()) {}
+
+        CHECK(is_map_parse_equal_to_ref(cell_check::Blocks_los()));
+        CHECK(is_map_parse_equal_to_ref(cell_check::Blocks_move_cmn(false)));
+        CHECK(is_map_parse_equal_to_ref(cell_check::Blocks_move_cmn(true)));
+        CHECK(is_map_parse_equal_to_ref(cell_check::Blocks_projectiles()));
+        CHECK(is_map_parse_equal_to_ref(cell_check::Blocks_actor(*map::player, true)));
+        CHECK(is_map_parse_equal_to_ref(cell_check::Blocks_items()));
+        CHECK(is_map_parse_equal_to_ref(cell_check::Is_feature(Feature_id::floor)));
+        CHECK(is_map_parse_equal_to_ref(cell_check::All_adj_is_feature(Feature_id::wall)));
+        CHECK(is_map_parse_equal_to_ref(
+                  cell_check::Living_actors_adj_to_pos(map::player->pos)));
+    }
+}
+
+TEST(MapBitsOps)
+{
+    //Compares the word level operations of Map_bits against the bool array versions
+    bool in[MAP_W][MAP_H];
+    bool other[MAP_W][MAP_H];
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            in[x][y]    = rnd::one_in(40);
+            other[x][y] = rnd::one_in(3);
+        }
+    }
+
+    //Make sure the word boundary and the map edges are exercised
+    in[63][10] = in[64][11] = in[0][0] = in[MAP_W - 1][MAP_H - 1] = true;
+
+    Map_bits in_bits;
+    Map_bits other_bits;
+    in_bits.from_array(in);
+    other_bits.from_array(other);
+
+    bool tmp[MAP_W][MAP_H];
+
+    in_bits.to_array(tmp);
+
+    int nr_set = 0;
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            CHECK_EQUAL(in[x][y], tmp[x][y]);
+
+            if (in[x][y]) {++nr_set;}
+        }
+    }
+
+    CHECK_EQUAL(nr_set, in_bits.popcount());
+
+    //Expand
+    for (int dist = 1; dist <= 3; ++dist)
+    {
+        bool expanded[MAP_W][MAP_H];
+        map_parse::expand(in, expanded, dist);
+
+        Map_bits expanded_bits;
+        map_parse::expand(in_bits, expanded_bits, dist);
+
+        Map_bits expected;
+        expected.from_array(expanded);
+
+        CHECK(expected == expanded_bits);
+    }
+
+    //Append
+    utils::copy_bool_array(in, tmp);
+    map_parse::append(tmp, other);
+
+    Map_bits appended_bits;
+    utils::copy_bool_array(in_bits, appended_bits);
+    map_parse::append(appended_bits, other_bits);
+
+    Map_bits expected;
+    expected.from_array(tmp);
+    CHECK(expected == appended_bits);
+
+    //And not
+    Map_bits and_not_bits = in_bits;
+    and_not_bits.and_not(other_bits);
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            CHECK_EQUAL(in[x][y] && !other[x][y], and_not_bits.at(x, y));
+        }
+    }
+
+    //Reverse
+    utils::copy_bool_array(in, tmp);
+    utils::reverse_bool_array(tmp);
+
+    Map_bits reversed_bits = in_bits;
+    utils::reverse_bool_array(reversed_bits);
+
+    expected.from_array(tmp);
+    CHECK(expected == reversed_bits);
+    CHECK_EQUAL(MAP_W * MAP_H - nr_set, reversed_bits.popcount());
+
+    //Value in area
+    for (int i = 0; i < 200; ++i)
+    {
+        const Pos p0(rnd::range(0, MAP_W - 1), rnd::range(0, MAP_H - 1));
+        const Pos p1(rnd::range(p0.x, MAP_W - 1), rnd::range(p0.y, MAP_H - 1));
+        const Rect area(p0, p1);
+
+        CHECK_EQUAL(map_parse::is_val_in_area(area, in, true),
+                    map_parse::is_val_in_area(area, in_bits, true));
+
+        CHECK_EQUAL(map_parse::is_val_in_area(area, other, false),
+                    map_parse::is_val_in_area(area, other_bits, false));
+    }
+}
+
+TEST_FIXTURE(BasicFixture, ActorPosIndex)
+{
+    const Pos p0(5, 5);
+    const Pos p1(6, 5);
+
+    map::put(new Floor(p0));
+    map::put(new Floor(p1));
+
+    Actor* const mon = actor_factory::mk(Actor_id::zombie, p0);
+
+    CHECK(utils::actor_at_pos(p0) == mon);
+    CHECK(utils::actor_at_pos(p1) == nullptr);
+
+    mon->set_pos(p1);
+
+    CHECK(utils::actor_at_pos(p0) == nullptr);
+    CHECK(utils::actor_at_pos(p1) == mon);
+    CHECK(utils::actor_at_pos(p1, Actor_state::corpse) == nullptr);
+    CHECK_EQUAL(1, int(game_time::actors_at_pos(p1).size()));
+
+    Smoke* const smoke = new Smoke(p0, 10);
+
+    game_time::add_mob(smoke);
+
+    CHECK(utils::first_mob_at_pos(p0) == smoke);
+    CHECK(utils::first_mob_at_pos(p1) == nullptr);
+
+    game_time::erase_mob(smoke, true);
+
+    CHECK(utils::first_mob_at_pos(p0) == nullptr);
+
+    actor_factory::delete_all_mon();
+
+    CHECK(game_time::actors_at_pos(p1).empty());
+}
+
+TEST_FIXTURE(BasicFixture, PropIdsFollowAppliedAndCarriedProps)
+{
+    Prop_handler& prop_handler = map::player->prop_handler();
+
+    CHECK(!prop_handler.has_prop(Prop_id::slowed));
+
+    prop_handler.try_apply_prop(new Prop_slowed(Prop_turns::std), true, true, true);
+
+    CHECK(prop_handler.has_prop(Prop_id::slowed));
+
+    prop_handler.end_applied_prop(Prop_id::slowed, false);
+
+    CHECK(!prop_handler.has_prop(Prop_id::slowed));
+
+    //Wearing a gas mask gives breath resistance, taking it off removes it
+    Inventory& inv = map::player->inv();
+
+    CHECK(!prop_handler.has_prop(Prop_id::rBreath));
+
+    inv.put_in_slot(Slot_id::head, item_factory::mk(Item_id::gas_mask));
+    inv.item_in_slot(Slot_id::head)->on_equip(true);
+
+    CHECK(prop_handler.has_prop(Prop_id::rBreath));
+
+    bool props[size_t(Prop_id::END)];
+    prop_handler.prop_ids(props);
+
+    CHECK(props[size_t(Prop_id::rBreath)]);
+
+    inv.item_in_slot(Slot_id::head)->on_unequip();
+    inv.move_to_general(Slot_id::head);
+
+    CHECK(!prop_handler.has_prop(Prop_id::rBreath));
+}
+
+TEST_FIXTURE(BasicFixture, LightMapFollowsLightSources)
+{
+    for (int x = 10; x <= 30; ++x)
+    {
+        for (int y = 2; y <= 12; ++y)
+        {
+            map::put(new Floor(Pos(x, y)));
+        }
+    }
+
+    game_time::update_light_map();
+
+    CHECK(!map::cells[20][7].is_lit);
+
+    Lit_flare* const flare = new Lit_flare(Pos(15, 7), 10);
+
+    game_time::add_mob(flare);
+    game_time::update_light_map();
+
+    CHECK(map::cells[15][7].is_lit);
+    CHECK(map::cells[20][7].is_lit);
+
+    //A wall blocks the light, the light of the flare must be computed again
+    map::put(new Wall(Pos(17, 7)));
+
+    game_time::update_light_map();
+
+    CHECK(map::cells[16][7].is_lit);
+    CHECK(!map::cells[20][7].is_lit);
+
+    //Burning rigids light their own cell
+    Rigid* const grass = map::put(new Grass(Pos(28, 10)));
+
+    grass->hit(Dmg_type::fire, Dmg_method::elemental);
+
+    game_time::update_light_map();
+
+    CHECK(map::cells[28][10].is_lit);
+    CHECK(!map::cells[27][10].is_lit);
+
+    grass->set_has_burned();
+
+    game_time::update_light_map();
+
+    CHECK(!map::cells[28][10].is_lit);
+
+    //Removing the light source unlights the cells
+    game_time::erase_mob(flare, true);
+    game_time::update_light_map();
+
+    CHECK(!map::cells[15][7].is_lit);
+    CHECK(!map::cells[16][7].is_lit);
+}
+
+TEST_FIXTURE(BasicFixture, ActiveRigids)
+{
+    //Walls are not active
+    CHECK(map::active_rigid_positions().empty());
+
+    const Pos stairs_pos(20, 10);
+    const Pos grass_pos(10, 10);
+
+    map::put(new Stairs(stairs_pos));
+
+    Rigid* const grass = map::put(new Grass(grass_pos));
+
+    CHECK_EQUAL(1, int(map::active_rigid_positions().size()));
+    CHECK(map::active_rigid_positions()[0] == stairs_pos);
+
+    //Burning grass is active (and comes first in the map order)
+    grass->hit(Dmg_type::fire, Dmg_method::elemental);
+
+    CHECK_EQUAL(2, int(map::active_rigid_positions().size()));
+    CHECK(map::active_rigid_positions()[0] == grass_pos);
+    CHECK(map::active_rigid_positions()[1] == stairs_pos);
+
+    grass->set_has_burned();
+
+    map::erase_inactive_rigids();
+
+    CHECK_EQUAL(1, int(map::active_rigid_positions().size()));
+    CHECK(map::active_rigid_positions()[0] == stairs_pos);
+}
+
+TEST_FIXTURE(BasicFixture, ActorSpeeds)
+{
+    for (int x = 10; x <= 20; ++x)
+    {
+        map::put(new Floor(Pos(x, 10)));
+    }
+
+    map::player->set_pos(Pos(10, 10));
+
+    Actor* const fast_mon = actor_factory::mk(Actor_id::wolf, Pos(12, 10));
+    Actor* const slow_mon = actor_factory::mk(Actor_id::mold, Pos(14, 10));
+
+    CHECK(map::player->speed()  == Actor_speed::normal);
+    CHECK(fast_mon->speed()     == Actor_speed::fast);
+    CHECK(slow_mon->speed()     == Actor_speed::slow);
+
+    //Count actions during some standard turns (without letting the actors do anything)
+    const int NR_TURNS = 60;
+
+    int nr_player_actions   = 0;
+    int nr_fast_actions     = 0;
+    int nr_slow_actions     = 0;
+
+    const int START_TURN = game_time::turn();
+
+    while (game_time::turn() - START_TURN < NR_TURNS)
+    {
+        const Actor* const actor = game_time::cur_actor();
+
+        if (actor == map::player)   {++nr_player_actions;}
+        if (actor == fast_mon)      {++nr_fast_actions;}
+        if (actor == slow_mon)      {++nr_slow_actions;}
+
+        game_time::tick();
+    }
+
+    //Normal speed actors act once per standard turn, fast actors four times per three
+    //standard turns, and slow actors twice per three standard turns
+    CHECK(abs(nr_player_actions - NR_TURNS)             <= 1);
+    CHECK(abs(nr_fast_actions   - (NR_TURNS * 4) / 3)   <= 1);
+    CHECK(abs(nr_slow_actions   - (NR_TURNS * 2) / 3)   <= 1);
+}
+
+TEST_FIXTURE(BasicFixture, SpeedChangeQueuesActorAgain)
+{
+    for (int x = 10; x <= 20; ++x)
+    {
+        map::put(new Floor(Pos(x, 10)));
+    }
+
+    map::player->set_pos(Pos(10, 10));
+
+    Actor* const mon = actor_factory::mk(Actor_id::mold, Pos(14, 10));
+
+    Prop_handler& prop_handler = mon->prop_handler();
+
+    //New actors are queued on the current step whether they may act or not, so let the
+    //player end its first turn
+    game_time::tick();
+
+    //A slow monster which is hasted during the player's turn has normal speed, and should
+    //act right after the player on each kind of step the player acts on
+    for (int i = 0; i < 3; ++i)
+    {
+        while (game_time::cur_actor() != map::player) {game_time::tick();}
+
+        prop_handler.try_apply_prop(new Prop_hasted(Prop_turns::indefinite), true, true, true);
+
+        CHECK(mon->speed() == Actor_speed::normal);
+
+        game_time::tick();
+
+        CHECK(game_time::cur_actor() == mon);
+
+        prop_handler.end_applied_prop(Prop_id::hasted, false);
+
+        game_time::tick();
+    }
+}
+
+TEST_FIXTURE(BasicFixture, MonsterSeesPlayerAfterMapChanges)
+{
+    for (int x = 10; x <= 20; ++x)
+    {
+        map::put(new Floor(Pos(x, 10)));
+    }
+
+    map::player->set_pos(Pos(10, 10));
+
+    Actor* const mon = actor_factory::mk(Actor_id::zombie, Pos(14, 10));
+
+    bool blocked_los[MAP_W][MAP_H];
+
+    map_parse::run(cell_check::Blocks_los(), blocked_los);
+
+    CHECK(mon->can_see_actor(*map::player, blocked_los));
+
+    //Asking again gives the same answer
+    CHECK(mon->can_see_actor(*map::player, blocked_los));
+
+    //A wall between the monster and the player blocks the view
+    map::put(new Wall(Pos(12, 10)));
+
+    map_parse::run(cell_check::Blocks_los(), blocked_los);
+
+    CHECK(!mon->can_see_actor(*map::player, blocked_los));
+
+    map::put(new Floor(Pos(12, 10)));
+
+    map_parse::run(cell_check::Blocks_los(), blocked_los);
+
+    CHECK(mon->can_see_actor(*map::player, blocked_los));
+}
+
+TEST_FIXTURE(BasicFixture, NxtLvlLayoutIsMadeOnWorker)
+{
+    for (int x = 10; x <= 20; ++x)
+    {
+        map::put(new Floor(Pos(x, 10)));
+    }
+
+    const Pos stairs_pos(20, 10);
+
+    map::put(new Stairs(stairs_pos));
+
+    map::player->set_pos(Pos(10, 10));
+
+    Actor* const mon = actor_factory::mk(Actor_id::zombie, Pos(14, 10));
+
+    const int   NR_ACTORS           = int(game_time::actors_.size());
+    const int   DLVL                = map::dlvl;
+    const long  NR_BUILD_ATTEMPTS   = map_travel::nr_lvl_build_attempts();
+
+    map_travel::prefetch_nxt_lvl();
+
+    //The current level is left as it was
+    CHECK(map::player->pos == Pos(10, 10));
+    CHECK_EQUAL(NR_ACTORS, int(game_time::actors_.size()));
+    CHECK_EQUAL(1, int(game_time::actors_at_pos(Pos(14, 10)).size()));
+    CHECK(game_time::actors_at_pos(Pos(14, 10))[0] == mon);
+    CHECK(map::cells[12][10].rigid->id()                == Feature_id::floor);
+    CHECK(map::cells[stairs_pos.x][stairs_pos.y].rigid->id() == Feature_id::stairs);
+    CHECK_EQUAL(DLVL, map::dlvl);
+
+    map::player->set_pos(stairs_pos);
+
+    map_travel::go_to_nxt();
+
+    CHECK(map_travel::nr_lvl_build_attempts() > NR_BUILD_ATTEMPTS);
+    CHECK_EQUAL(DLVL + 1, map::dlvl);
+
+    const Pos& p = map::player->pos;
+
+    CHECK(map::cells[p.x][p.y].rigid->can_move_cmn());
+    CHECK(count(begin(game_time::actors_), end(game_time::actors_), map::player) == 1);
+
+    //The layout is used wherever the player leaves from (e.g. a trapdoor)
+    map_travel::prefetch_nxt_lvl();
+
+    map::player->set_pos(Pos(1, 1));
+
+    map_travel::go_to_nxt();
+
+    CHECK_EQUAL(DLVL + 2, map::dlvl);
+
+    const Pos& p2 = map::player->pos;
+
+    CHECK(map::cells[p2.x][p2.y].rigid->can_move_cmn());
+}
+
+TEST_FIXTURE(BasicFixture, LvlLayoutIsMovedAndPopulated)
+{
+    rnd::seed(1);
+
+    map::dlvl = 3;
+
+    map_gen::is_mk_items_deferred = true;
+
+    while (!map_gen::mk_std_lvl_layout()) {}
+
+    map_gen::is_mk_items_deferred = false;
+
+    const size_t NR_ROOMS = map::room_list.size();
+
+    CHECK(NR_ROOMS > 0);
+
+    unique_ptr<Lvl_layout> layout(new Lvl_layout);
+
+    map::export_layout(*layout);
+
+    //The layout is moved out, and the map is left empty
+    CHECK(map::room_list.empty());
+    CHECK_EQUAL(NR_ROOMS, layout->room_list.size());
+    CHECK(map::active_rigid_positions().empty());
+
+    bool is_map_empty = true;
+
+    for (int x = 0; x < MAP_W; ++x)
+    {
+        for (int y = 0; y < MAP_H; ++y)
+        {
+            if (map::cells[x][y].rigid || map::room_map[x][y]) {is_map_empty = false;}
+        }
+    }
+
+    CHECK(is_map_empty);
+
+    map::import_layout(*layout);
+
+    CHECK_EQUAL(NR_ROOMS, map::room_list.size());
+    CHECK(layout->room_list.empty());
+
+    map_gen::mk_deferred_items();
+
+    if (map_gen::populate_std_lvl())
+    {
+        int nr_stairs = 0;
+
+        for (int x = 0; x < MAP_W; ++x)
+        {
+            for (int y = 0; y < MAP_H; ++y)
+            {
+                if (map::cells[x][y].rigid->id() == Feature_id::stairs) {++nr_stairs;}
+            }
+        }
+
+        CHECK_EQUAL(1, nr_stairs);
+    }
+
+    //The rooms are only kept until the level is populated
+    CHECK(map::room_list.empty());
+}
+
 //-----------------------------------------------------------------------------
 // Some code exercise - Ichi! Ni! San!
 //-----------------------------------------------------------------------------
@@ -1368,8 +2385,10 @@ TEST_FIXTURE(BasicFixture, mapParseGetCellsWithinDistOfOthers)
 #endif
 int main()
 {
-    UnitTest::RunAllTests();
-    return 0;
-}
-
+    //NOTE: The IO is not initialized, so queries and "more" prompts return immediately
+    //instead of waiting for keys, and the render backend is set to none so that nothing
+    //is drawn either
+    config::set_render_backend(Render_backend::none);
 
+    return UnitTest::RunAllTests();
+}